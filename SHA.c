@@ -0,0 +1,2779 @@
+/*
+ * This file was generated automatically by ExtUtils::ParseXS version 3.45 from the
+ * contents of SHA.xs. Do not edit this file, edit SHA.xs instead.
+ *
+ *    ANY CHANGES MADE HERE WILL BE LOST!
+ *
+ */
+
+#line 1 "SHA.xs"
+#include "EXTERN.h"
+#include "perl.h"
+#include "XSUB.h"
+
+#ifdef SvPVbyte
+	#if PERL_REVISION == 5 && PERL_VERSION < 8
+		#undef SvPVbyte
+		#define SvPVbyte(sv, lp) \
+			(sv_utf8_downgrade((sv), 0), SvPV((sv), (lp)))
+	#endif
+#else
+	#define SvPVbyte SvPV
+#endif
+
+#ifndef PerlIO
+	#define PerlIO				FILE
+	#define PerlIO_read(f, buf, count)	fread(buf, 1, count, f)
+	#define PerlIO_fileno(f)		fileno(f)
+	#define PerlIO_tell(f)			ftell(f)
+	#define PerlIO_seek(f, off, whence)	fseek(f, off, whence)
+#endif
+
+#ifndef sv_derived_from
+	#include "src/sdf.c"
+#endif
+
+#ifndef Newx
+	#define Newx(ptr, num, type)	New(0, ptr, num, type)
+	#define Newxz(ptr, num, type)	Newz(0, ptr, num, type)
+#endif
+
+#include "src/sha.c"
+#include "src/shapool.c"
+#include "src/shaio.c"
+#include "src/shatree.c"
+#include "src/shacdc.c"
+#include "src/shacache.c"
+#include "src/shackpt.c"
+#include "src/shaasync.c"
+
+static int ix2alg[] =
+	{1,1,1,224,224,224,256,256,256,384,384,384,512,512,512,
+	512224,512224,512224,512256,512256,512256};
+
+#ifndef INT2PTR
+#define INT2PTR(p, i) (p) (i)
+#endif
+
+#define IO_BUFFER_SIZE 4096
+#define MANY_BATCH_SIZE 32
+
+static SHA *getSHA(SV *self)
+{
+	if (!sv_isobject(self) || !sv_derived_from(self, "Digest::SHA"))
+		return(NULL);
+	return INT2PTR(SHA *, SvIV(SvRV(self)));
+}
+
+#ifdef MULTIPLICITY
+	#define SHA_INTERP	((void *) aTHX)
+#else
+	#define SHA_INTERP	NULL
+#endif
+
+#ifdef call_atexit
+/*
+ * asyncexit: forgets this interpreter's background jobs at its end;
+ * looks them up by interpreter, since clones inherit the exit list
+ */
+static void asyncexit(pTHX_ void *arg)
+{
+	(void) arg;
+	asyncdrop(SHA_INTERP);
+}
+#endif
+
+/* asyncself: returns the owner of this interpreter's background jobs */
+static SHAOWNER *asyncself(pTHX)
+{
+	SHAOWNER *o;
+	int made;
+
+	o = asyncowner(SHA_INTERP, &made);
+#ifdef call_atexit
+	if (o != NULL && made)
+		call_atexit(asyncexit, NULL);
+#endif
+	return(o);
+}
+
+#ifdef SHA_CACHE
+static SHACACHE *getCache(SV *self)
+{
+	if (!sv_isobject(self) || !sv_derived_from(self, "Digest::SHA::Cache"))
+		return(NULL);
+	return INT2PTR(SHACACHE *, SvIV(SvRV(self)));
+}
+#endif
+
+static SHATREE *getTree(SV *self)
+{
+	if (!sv_isobject(self) || !sv_derived_from(self, "Digest::SHA::Tree"))
+		return(NULL);
+	return INT2PTR(SHATREE *, SvIV(SvRV(self)));
+}
+
+static HMAC *getHMAC(SV *self)
+{
+	if (!sv_isobject(self) || !sv_derived_from(self, "Digest::SHA::HMAC"))
+		return(NULL);
+	return INT2PTR(HMAC *, SvIV(SvRV(self)));
+}
+
+/* enclen: returns length of an n-byte digest in the given format */
+static STRLEN enclen(UINT n, int format)
+{
+	return(format == 0 ? n : format == 1 ? HEXLEN(n) : B64LEN(n));
+}
+
+/*
+ * encode: writes digest d (n bytes) to out as binary (0), hex (1), or
+ * base64 (2), followed by a NUL; returns the length written
+ */
+static STRLEN encode(UCHR *d, UINT n, int format, int flags, char *out)
+{
+	if (format == 1)
+		return(hexenc(d, n, out));
+	if (format == 2)
+		return(b64enc(d, n, out, flags));
+	Copy(d, out, n, char);
+	out[n] = '\0';
+	return(n);
+}
+
+/*
+ * encsv: returns a new SV holding digest d (n bytes) as binary (0),
+ * hex (1), or base64 (2), encoded straight into the SV's buffer
+ */
+static SV *encsv(UCHR *d, UINT n, int format, int flags)
+{
+	SV *sv;
+	char *p;
+
+	sv = newSV(enclen(n, format) + 2);
+	p = SvPVX(sv);
+	SvCUR_set(sv, encode(d, n, format, flags, p));
+	SvPOK_only(sv);
+	return(sv);
+}
+
+/*
+ * intobuf: readies the string in sv to receive len bytes at offset,
+ * keeping the bytes before offset (and zero-filling up to it), and
+ * reallocating only if the buffer is too small; returns the place to
+ * write, or NULL if sv can't be written
+ */
+static char *intobuf(SV *sv, IV offset, STRLEN len)
+{
+	STRLEN cur;
+	char *p;
+
+	if (offset < 0 || SvREADONLY(sv))
+		return(NULL);
+	if (!SvOK(sv))
+		sv_setpvn(sv, "", 0);
+	(void) SvPV_force(sv, cur);
+	if (SvUTF8(sv) && !sv_utf8_downgrade(sv, 1))
+		return(NULL);
+	cur = SvCUR(sv);
+	p = SvGROW(sv, (STRLEN) offset + len + 1);
+	if ((STRLEN) offset > cur)
+		Zero(p + cur, (STRLEN) offset - cur, char);
+	SvCUR_set(sv, (STRLEN) offset + len);
+	SvPOK_only(sv);
+	return(p + offset);
+}
+
+/* digestsv: returns finished digest as binary (0), hex (1), or base64 (2) */
+static SV *digestsv(SHA *s, int format)
+{
+	return(encsv(shadigest(s), s->digestlen, format, 0));
+}
+
+#if defined(SHA_STATS)
+
+#if UVSIZE >= 8
+	#define STATSV(n)	newSVuv((UV) (n))
+#else
+	#define STATSV(n)	newSVnv((NV) (n))
+#endif
+
+#define STATSTORE(hv, st, field) \
+	(void) hv_store(hv, #field, sizeof(#field) - 1, STATSV((st)->field), 0)
+
+/* statsref: returns a reference to a hash holding the counters in st */
+static SV *statsref(SHASTATS *st)
+{
+	HV *hv = newHV();
+
+	STATSTORE(hv, st, blocks);
+	STATSTORE(hv, st, direct);
+	STATSTORE(hv, st, bytes);
+	STATSTORE(hv, st, bits);
+	STATSTORE(hv, st, partial);
+	STATSTORE(hv, st, finish);
+	STATSTORE(hv, st, reads);
+	STATSTORE(hv, st, readbytes);
+	return(newRV_noinc((SV *) hv));
+}
+
+#endif
+
+/* slabstate: stores a new object for checkpoint rec (or undef) in AV arg */
+static void slabstate(void *arg, long i, UCHR *rec)
+{
+	dTHX;
+	SHA *state;
+	SV *sv = newSV(0);
+
+	if ((state = shaalloc()) != NULL) {
+		if (ckptload(state, rec, CKPT_LEN)) {
+			sv_setref_pv(sv, "Digest::SHA", (void *) state);
+			SvREADONLY_on(SvRV(sv));
+		}
+		else
+			shafree(state);
+	}
+	av_store((AV *) arg, (I32) i, sv);
+}
+
+static SHACDC *getCDC(SV *self)
+{
+	if (!sv_isobject(self) || !sv_derived_from(self, "Digest::SHA::CDC"))
+		return(NULL);
+	return INT2PTR(SHACDC *, SvIV(SvRV(self)));
+}
+
+/* cdcchunk: finishes the current chunk, returning [offset, length, digest] */
+static SV *cdcchunk(SHACDC *c)
+{
+	AV *chunk = newAV();
+
+#if UVSIZE >= 8
+	av_push(chunk, newSVuv(((UV) c->offhi << 32) + c->offlo));
+#else
+	av_push(chunk, c->offhi ? newSVnv(c->offhi * 4294967296.0 + c->offlo)
+		: newSVuv(c->offlo));
+#endif
+	av_push(chunk, newSVuv(c->len));
+	shafinish(&c->sha);
+	av_push(chunk, digestsv(&c->sha, c->format));
+	cdcnext(c);
+	return(newRV_noinc((SV *) chunk));
+}
+
+#line 266 "SHA.c"
+#ifndef PERL_UNUSED_VAR
+#  define PERL_UNUSED_VAR(var) if (0) var = var
+#endif
+
+#ifndef dVAR
+#  define dVAR		dNOOP
+#endif
+
+
+/* This stuff is not part of the API! You have been warned. */
+#ifndef PERL_VERSION_DECIMAL
+#  define PERL_VERSION_DECIMAL(r,v,s) (r*1000000 + v*1000 + s)
+#endif
+#ifndef PERL_DECIMAL_VERSION
+#  define PERL_DECIMAL_VERSION \
+	  PERL_VERSION_DECIMAL(PERL_REVISION,PERL_VERSION,PERL_SUBVERSION)
+#endif
+#ifndef PERL_VERSION_GE
+#  define PERL_VERSION_GE(r,v,s) \
+	  (PERL_DECIMAL_VERSION >= PERL_VERSION_DECIMAL(r,v,s))
+#endif
+#ifndef PERL_VERSION_LE
+#  define PERL_VERSION_LE(r,v,s) \
+	  (PERL_DECIMAL_VERSION <= PERL_VERSION_DECIMAL(r,v,s))
+#endif
+
+/* XS_INTERNAL is the explicit static-linkage variant of the default
+ * XS macro.
+ *
+ * XS_EXTERNAL is the same as XS_INTERNAL except it does not include
+ * "STATIC", ie. it exports XSUB symbols. You probably don't want that
+ * for anything but the BOOT XSUB.
+ *
+ * See XSUB.h in core!
+ */
+
+
+/* TODO: This might be compatible further back than 5.10.0. */
+#if PERL_VERSION_GE(5, 10, 0) && PERL_VERSION_LE(5, 15, 1)
+#  undef XS_EXTERNAL
+#  undef XS_INTERNAL
+#  if defined(__CYGWIN__) && defined(USE_DYNAMIC_LOADING)
+#    define XS_EXTERNAL(name) __declspec(dllexport) XSPROTO(name)
+#    define XS_INTERNAL(name) STATIC XSPROTO(name)
+#  endif
+#  if defined(__SYMBIAN32__)
+#    define XS_EXTERNAL(name) EXPORT_C XSPROTO(name)
+#    define XS_INTERNAL(name) EXPORT_C STATIC XSPROTO(name)
+#  endif
+#  ifndef XS_EXTERNAL
+#    if defined(HASATTRIBUTE_UNUSED) && !defined(__cplusplus)
+#      define XS_EXTERNAL(name) void name(pTHX_ CV* cv __attribute__unused__)
+#      define XS_INTERNAL(name) STATIC void name(pTHX_ CV* cv __attribute__unused__)
+#    else
+#      ifdef __cplusplus
+#        define XS_EXTERNAL(name) extern "C" XSPROTO(name)
+#        define XS_INTERNAL(name) static XSPROTO(name)
+#      else
+#        define XS_EXTERNAL(name) XSPROTO(name)
+#        define XS_INTERNAL(name) STATIC XSPROTO(name)
+#      endif
+#    endif
+#  endif
+#endif
+
+/* perl >= 5.10.0 && perl <= 5.15.1 */
+
+
+/* The XS_EXTERNAL macro is used for functions that must not be static
+ * like the boot XSUB of a module. If perl didn't have an XS_EXTERNAL
+ * macro defined, the best we can do is assume XS is the same.
+ * Dito for XS_INTERNAL.
+ */
+#ifndef XS_EXTERNAL
+#  define XS_EXTERNAL(name) XS(name)
+#endif
+#ifndef XS_INTERNAL
+#  define XS_INTERNAL(name) XS(name)
+#endif
+
+/* Now, finally, after all this mess, we want an ExtUtils::ParseXS
+ * internal macro that we're free to redefine for varying linkage due
+ * to the EXPORT_XSUB_SYMBOLS XS keyword. This is internal, use
+ * XS_EXTERNAL(name) or XS_INTERNAL(name) in your code if you need to!
+ */
+
+#undef XS_EUPXS
+#if defined(PERL_EUPXS_ALWAYS_EXPORT)
+#  define XS_EUPXS(name) XS_EXTERNAL(name)
+#else
+   /* default to internal */
+#  define XS_EUPXS(name) XS_INTERNAL(name)
+#endif
+
+#ifndef PERL_ARGS_ASSERT_CROAK_XS_USAGE
+#define PERL_ARGS_ASSERT_CROAK_XS_USAGE assert(cv); assert(params)
+
+/* prototype to pass -Wmissing-prototypes */
+STATIC void
+S_croak_xs_usage(const CV *const cv, const char *const params);
+
+STATIC void
+S_croak_xs_usage(const CV *const cv, const char *const params)
+{
+    const GV *const gv = CvGV(cv);
+
+    PERL_ARGS_ASSERT_CROAK_XS_USAGE;
+
+    if (gv) {
+        const char *const gvname = GvNAME(gv);
+        const HV *const stash = GvSTASH(gv);
+        const char *const hvname = stash ? HvNAME(stash) : NULL;
+
+        if (hvname)
+	    Perl_croak_nocontext("Usage: %s::%s(%s)", hvname, gvname, params);
+        else
+	    Perl_croak_nocontext("Usage: %s(%s)", gvname, params);
+    } else {
+        /* Pants. I don't think that it should be possible to get here. */
+	Perl_croak_nocontext("Usage: CODE(0x%" UVxf ")(%s)", PTR2UV(cv), params);
+    }
+}
+#undef  PERL_ARGS_ASSERT_CROAK_XS_USAGE
+
+#define croak_xs_usage        S_croak_xs_usage
+
+#endif
+
+/* NOTE: the prototype of newXSproto() is different in versions of perls,
+ * so we define a portable version of newXSproto()
+ */
+#ifdef newXS_flags
+#define newXSproto_portable(name, c_impl, file, proto) newXS_flags(name, c_impl, file, proto, 0)
+#else
+#define newXSproto_portable(name, c_impl, file, proto) (PL_Sv=(SV*)newXS(name, c_impl, file), sv_setpv(PL_Sv, proto), (CV*)PL_Sv)
+#endif /* !defined(newXS_flags) */
+
+#if PERL_VERSION_LE(5, 21, 5)
+#  define newXS_deffile(a,b) Perl_newXS(aTHX_ a,b,file)
+#else
+#  define newXS_deffile(a,b) Perl_newXS_deffile(aTHX_ a,b)
+#endif
+
+#line 410 "SHA.c"
+
+XS_EUPXS(XS_Digest__SHA_shadispatch); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_shadispatch)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "mask");
+    {
+	int	mask = (int)SvIV(ST(0))
+;
+	int	RETVAL;
+	dXSTARG;
+
+	RETVAL = shadispatch(mask);
+	XSprePUSH;
+	PUSHi((IV)RETVAL);
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__cpuid); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__cpuid)
+{
+    dVAR; dXSARGS;
+    if (items != 0)
+       croak_xs_usage(cv,  "");
+    {
+	int	RETVAL;
+	dXSTARG;
+#line 271 "SHA.xs"
+	RETVAL = shacpuid();
+#line 443 "SHA.c"
+	XSprePUSH;
+	PUSHi((IV)RETVAL);
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__cycles); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__cycles)
+{
+    dVAR; dXSARGS;
+    if (items != 0)
+       croak_xs_usage(cv,  "");
+    {
+	NV	RETVAL;
+	dXSTARG;
+#line 278 "SHA.xs"
+	RETVAL = shacycles();
+#line 462 "SHA.c"
+	XSprePUSH;
+	PUSHn((NV)RETVAL);
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA_shainit); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_shainit)
+{
+    dVAR; dXSARGS;
+    if (items != 2)
+       croak_xs_usage(cv,  "s, alg");
+    {
+	SHA *	s = getSHA(ST(0))
+;
+	int	alg = (int)SvIV(ST(1))
+;
+	int	RETVAL;
+	dXSTARG;
+
+	RETVAL = shainit(s, alg);
+	XSprePUSH;
+	PUSHi((IV)RETVAL);
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA_sharewind); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_sharewind)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "s");
+    {
+	SHA *	s = getSHA(ST(0))
+;
+
+	sharewind(s);
+    }
+    XSRETURN_EMPTY;
+}
+
+
+XS_EUPXS(XS_Digest__SHA_shawrite); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_shawrite)
+{
+    dVAR; dXSARGS;
+    if (items != 3)
+       croak_xs_usage(cv,  "bitstr, bitcnt, s");
+    {
+	unsigned char *	bitstr = (unsigned char *)SvPV_nolen(ST(0))
+;
+	unsigned long	bitcnt = (unsigned long)SvUV(ST(1))
+;
+	SHA *	s = getSHA(ST(2))
+;
+	unsigned long	RETVAL;
+	dXSTARG;
+
+	RETVAL = shawrite(bitstr, bitcnt, s);
+	XSprePUSH;
+	PUSHu((UV)RETVAL);
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA_newSHA); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_newSHA)
+{
+    dVAR; dXSARGS;
+    if (items != 2)
+       croak_xs_usage(cv,  "classname, alg");
+    {
+	char *	classname = (char *)SvPV_nolen(ST(0))
+;
+	int	alg = (int)SvIV(ST(1))
+;
+#line 302 "SHA.xs"
+	SHA *state;
+#line 545 "SHA.c"
+	SV *	RETVAL;
+#line 304 "SHA.xs"
+	if ((state = shaalloc()) == NULL)
+		XSRETURN_UNDEF;
+	if (!shainit(state, alg)) {
+		shafree(state);
+		XSRETURN_UNDEF;
+	}
+	RETVAL = newSV(0);
+	sv_setref_pv(RETVAL, classname, (void *) state);
+	SvREADONLY_on(SvRV(RETVAL));
+#line 557 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA_clone); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_clone)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    {
+	SV *	self = ST(0)
+;
+#line 320 "SHA.xs"
+	SHA *state;
+	SHA *clone;
+#line 577 "SHA.c"
+	SV *	RETVAL;
+#line 323 "SHA.xs"
+	if ((state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	if ((clone = shaalloc()) == NULL)
+		XSRETURN_UNDEF;
+	RETVAL = newSV(0);
+	sv_setref_pv(RETVAL, sv_reftype(SvRV(self), 1), (void *) clone);
+	SvREADONLY_on(SvRV(RETVAL));
+	Copy(state, clone, 1, SHA);
+#line 588 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA_DESTROY); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_DESTROY)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "s");
+    {
+	SHA *	s = getSHA(ST(0))
+;
+#line 338 "SHA.xs"
+	shafree(s);
+#line 607 "SHA.c"
+    }
+    XSRETURN_EMPTY;
+}
+
+
+XS_EUPXS(XS_Digest__SHA_sha1); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_sha1)
+{
+    dVAR; dXSARGS;
+    dXSI32;
+    PERL_UNUSED_VAR(cv); /* -W */
+    PERL_UNUSED_VAR(items); /* -W */
+    {
+#line 365 "SHA.xs"
+	int i;
+	UCHR *data;
+	STRLEN len;
+	SHA sha;
+#line 626 "SHA.c"
+	SV *	RETVAL;
+#line 370 "SHA.xs"
+	if (!shainit(&sha, ix2alg[ix]))
+		XSRETURN_UNDEF;
+	for (i = 0; i < items; i++) {
+		data = (UCHR *) (SvPVbyte(ST(i), len));
+		shawritebytes(data, len, &sha);
+	}
+	shafinish(&sha);
+	RETVAL = digestsv(&sha, ix % 3);
+#line 637 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA_sha1_many); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_sha1_many)
+{
+    dVAR; dXSARGS;
+    dXSI32;
+    if (items != 1)
+       croak_xs_usage(cv,  "aref");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	SV *	aref = ST(0)
+;
+#line 407 "SHA.xs"
+	int j, k;
+	SSize_t n, base;
+	AV *av;
+	SV **svp;
+	STRLEN len;
+	SHA sha[MANY_BATCH_SIZE];
+	UCHR *data[MANY_BATCH_SIZE];
+	size_t size[MANY_BATCH_SIZE];
+#line 666 "SHA.c"
+#line 416 "SHA.xs"
+	if (!SvROK(aref) || SvTYPE(SvRV(aref)) != SVt_PVAV)
+		XSRETURN_EMPTY;
+	if (!shainit(&sha[0], ix2alg[ix]))
+		XSRETURN_EMPTY;
+	av = (AV *) SvRV(aref);
+	n = av_len(av) + 1;
+	EXTEND(SP, n);
+	for (base = 0; base < n; base += k) {
+		k = n - base < MANY_BATCH_SIZE ? (int) (n - base) :
+			MANY_BATCH_SIZE;
+		for (j = 0; j < k; j++) {
+			len = 0;
+			svp = av_fetch(av, base + j, 0);
+			data[j] = svp ? (UCHR *) (SvPVbyte(*svp, len)) :
+				(UCHR *) "";
+			size[j] = len;
+			shainit(&sha[j], ix2alg[ix]);
+		}
+		shamulti(sha, data, size, k);
+		for (j = 0; j < k; j++)
+			PUSHs(sv_2mortal(digestsv(&sha[j], ix % 3)));
+	}
+#line 690 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA_sha1_into); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_sha1_into)
+{
+    dVAR; dXSARGS;
+    dXSI32;
+    if (items < 1)
+       croak_xs_usage(cv,  "buf, ...");
+    {
+	SV *	buf = ST(0)
+;
+#line 465 "SHA.xs"
+	int i;
+	UCHR *data;
+	STRLEN len;
+	SHA sha;
+	char *p;
+#line 713 "SHA.c"
+	SV *	RETVAL;
+#line 471 "SHA.xs"
+	if (!shainit(&sha, ix2alg[ix]))
+		XSRETURN_UNDEF;
+	for (i = 1; i < items; i++) {
+		data = (UCHR *) (SvPVbyte(ST(i), len));
+		shawritebytes(data, len, &sha);
+	}
+	shafinish(&sha);
+	len = enclen(sha.digestlen, ix % 3);
+	if ((p = intobuf(buf, 0, len)) == NULL)
+		XSRETURN_UNDEF;
+	encode(shadigest(&sha), sha.digestlen, ix % 3, 0, p);
+	SvSETMAGIC(buf);
+	RETVAL = newSVuv(len);
+#line 729 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA_hmac_sha1); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_hmac_sha1)
+{
+    dVAR; dXSARGS;
+    dXSI32;
+    PERL_UNUSED_VAR(cv); /* -W */
+    PERL_UNUSED_VAR(items); /* -W */
+    {
+#line 512 "SHA.xs"
+	int i;
+	UCHR *key = (UCHR *) "";
+	UCHR *data;
+	STRLEN len = 0;
+	HMAC hmac;
+#line 751 "SHA.c"
+	SV *	RETVAL;
+#line 518 "SHA.xs"
+	if (items > 0) {
+		key = (UCHR *) (SvPVbyte(ST(items-1), len));
+	}
+	if (hmacinit(&hmac, ix2alg[ix], key, len) == NULL)
+		XSRETURN_UNDEF;
+	for (i = 0; i < items - 1; i++) {
+		data = (UCHR *) (SvPVbyte(ST(i), len));
+		hmacwritebytes(data, len, &hmac);
+	}
+	hmacfinish(&hmac);
+	RETVAL = digestsv(&hmac.osha, ix % 3);
+#line 765 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA_hashsize); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_hashsize)
+{
+    dVAR; dXSARGS;
+    dXSI32;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    {
+	SV *	self = ST(0)
+;
+#line 539 "SHA.xs"
+	SHA *state;
+#line 785 "SHA.c"
+	int	RETVAL;
+	dXSTARG;
+#line 541 "SHA.xs"
+	if ((state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	RETVAL = ix ? state->alg : (int) (state->digestlen << 3);
+#line 792 "SHA.c"
+	XSprePUSH;
+	PUSHi((IV)RETVAL);
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA_stats); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_stats)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    {
+	SV *	self = ST(0)
+;
+#line 551 "SHA.xs"
+	SHA *state;
+#line 811 "SHA.c"
+	SV *	RETVAL;
+#line 553 "SHA.xs"
+	if ((state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+#if defined(SHA_STATS)
+	RETVAL = statsref(&state->stats);
+#else
+	XSRETURN_UNDEF;
+#endif
+#line 821 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA_global_stats); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_global_stats)
+{
+    dVAR; dXSARGS;
+    if (items != 0)
+       croak_xs_usage(cv,  "");
+    {
+	SV *	RETVAL;
+#line 566 "SHA.xs"
+#if defined(SHA_STATS)
+	RETVAL = statsref(&shastats);
+#else
+	XSRETURN_UNDEF;
+#endif
+#line 843 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA_add); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_add)
+{
+    dVAR; dXSARGS;
+    if (items < 1)
+       croak_xs_usage(cv,  "self, ...");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	SV *	self = ST(0)
+;
+#line 578 "SHA.xs"
+	int i;
+	UCHR *data;
+	STRLEN len;
+	SHA *state;
+#line 867 "SHA.c"
+#line 583 "SHA.xs"
+	if ((state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	for (i = 1; i < items; i++) {
+		data = (UCHR *) (SvPVbyte(ST(i), len));
+		shawritebytes(data, len, state);
+	}
+	XSRETURN(1);
+#line 876 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA_digest); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_digest)
+{
+    dVAR; dXSARGS;
+    dXSI32;
+    if (items < 1)
+       croak_xs_usage(cv,  "self, ...");
+    {
+	SV *	self = ST(0)
+;
+#line 599 "SHA.xs"
+	int i;
+	int flags = 0;
+	char *opt;
+	SHA *state;
+#line 898 "SHA.c"
+	SV *	RETVAL;
+#line 604 "SHA.xs"
+	if ((state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	if (items > 1 && (ix != 2 || items % 2 == 0))
+		XSRETURN_UNDEF;		/* options are for b64digest */
+	for (i = 1; i + 1 < items; i += 2) {
+		opt = SvPV_nolen(ST(i));
+		if (strEQ(opt, "url"))
+			flags |= SvTRUE(ST(i+1)) ? SHA_B64_URL : 0;
+		else if (strEQ(opt, "pad"))
+			flags |= SvTRUE(ST(i+1)) ? SHA_B64_PAD : 0;
+		else
+			XSRETURN_UNDEF;
+	}
+	shafinish(state);
+	RETVAL = encsv(shadigest(state), state->digestlen, ix, flags);
+	sharewind(state);
+#line 917 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA_digest_into); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_digest_into)
+{
+    dVAR; dXSARGS;
+    dXSI32;
+    if (items < 2 || items > 3)
+       croak_xs_usage(cv,  "self, buf, offset = 0");
+    {
+	SV *	self = ST(0)
+;
+	SV *	buf = ST(1)
+;
+	IV	offset;
+#line 633 "SHA.xs"
+	SHA *state;
+	STRLEN len;
+	char *p;
+#line 942 "SHA.c"
+	SV *	RETVAL;
+
+	if (items < 3)
+	    offset = 0;
+	else {
+	    offset = (IV)SvIV(ST(2))
+;
+	}
+#line 637 "SHA.xs"
+	if ((state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	len = enclen(state->digestlen, ix);
+	if ((p = intobuf(buf, offset, len)) == NULL)
+		XSRETURN_UNDEF;
+	shafinish(state);
+	encode(shadigest(state), state->digestlen, ix, 0, p);
+	SvSETMAGIC(buf);
+	sharewind(state);
+	RETVAL = newSVuv(len);
+#line 962 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__getstate); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__getstate)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    {
+	SV *	self = ST(0)
+;
+#line 654 "SHA.xs"
+	SHA *state;
+	UCHR buf[SHA_MAX_STATE_LEN];
+	UINT len;
+#line 983 "SHA.c"
+	SV *	RETVAL;
+#line 658 "SHA.xs"
+	if ((state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	len = shapack(state, buf);
+	RETVAL = newSVpv((char *) buf, (STRLEN) len);
+#line 990 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__putstate); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__putstate)
+{
+    dVAR; dXSARGS;
+    if (items != 2)
+       croak_xs_usage(cv,  "self, packed_state");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	SV *	self = ST(0)
+;
+	SV *	packed_state = ST(1)
+;
+#line 670 "SHA.xs"
+	STRLEN len;
+	SHA *state;
+	UCHR *data;
+#line 1015 "SHA.c"
+#line 674 "SHA.xs"
+	if ((state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	data = (UCHR *) SvPV(packed_state, len);
+	if (len > SHA_MAX_STATE_LEN || !shaunpack(state, data, (UINT) len))
+		XSRETURN_UNDEF;
+	XSRETURN(1);
+#line 1023 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA_checkpoint); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_checkpoint)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    {
+	SV *	self = ST(0)
+;
+#line 685 "SHA.xs"
+	SHA *state;
+	UCHR rec[CKPT_LEN];
+#line 1042 "SHA.c"
+	SV *	RETVAL;
+#line 688 "SHA.xs"
+	if ((state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	ckptsave(state, rec);
+	RETVAL = newSVpvn((char *) rec, CKPT_LEN);
+#line 1049 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__resume); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__resume)
+{
+    dVAR; dXSARGS;
+    if (items != 2)
+       croak_xs_usage(cv,  "self, ckpt");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	SV *	self = ST(0)
+;
+	SV *	ckpt = ST(1)
+;
+#line 700 "SHA.xs"
+	STRLEN len;
+	SHA *state;
+	UCHR *data;
+#line 1074 "SHA.c"
+#line 704 "SHA.xs"
+	if ((state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	data = (UCHR *) SvPVbyte(ckpt, len);
+	if (!ckptload(state, data, len))
+		XSRETURN_UNDEF;
+	XSRETURN(1);
+#line 1082 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA_save_states); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_save_states)
+{
+    dVAR; dXSARGS;
+    if (items < 1)
+       croak_xs_usage(cv,  "file, ...");
+    {
+	char *	file = (char *)SvPV_nolen(ST(0))
+;
+#line 715 "SHA.xs"
+	int i, ok;
+	SHA **states;
+#line 1101 "SHA.c"
+	SV *	RETVAL;
+#line 718 "SHA.xs"
+	Newx(states, items, SHA *);
+	for (i = 1; i < items; i++)
+		if ((states[i-1] = getSHA(ST(i))) == NULL) {
+			Safefree(states);
+			XSRETURN_UNDEF;
+		}
+	ok = slabsave(file, states, items - 1);
+	Safefree(states);
+	if (!ok)
+		XSRETURN_UNDEF;
+	RETVAL = newSViv(items - 1);
+#line 1115 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA_load_states); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_load_states)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "file");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	char *	file = (char *)SvPV_nolen(ST(0))
+;
+#line 736 "SHA.xs"
+	AV *av;
+	long i, n;
+#line 1137 "SHA.c"
+#line 739 "SHA.xs"
+	av = (AV *) sv_2mortal((SV *) newAV());
+	if ((n = slabload(file, slabstate, (void *) av)) < 0)
+		XSRETURN_EMPTY;
+	EXTEND(SP, n);
+	for (i = 0; i < n; i++)
+		PUSHs(sv_2mortal(SvREFCNT_inc(*av_fetch(av, (I32) i, 0))));
+#line 1145 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA__addfilebin); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__addfilebin)
+{
+    dVAR; dXSARGS;
+    if (items != 2)
+       croak_xs_usage(cv,  "self, f");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	SV *	self = ST(0)
+;
+	PerlIO *	f = IoIFP(sv_2io(ST(1)))
+;
+#line 751 "SHA.xs"
+	SHA *state;
+	int n;
+	UCHR in[IO_BUFFER_SIZE];
+#line 1169 "SHA.c"
+#line 755 "SHA.xs"
+	if (!f || (state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	while ((n = PerlIO_read(f, in, sizeof(in))) > 0) {
+		SHA_STAT(state, reads, 1);
+		SHA_STAT(state, readbytes, n);
+		shawrite(in, (ULNG) n << 3, state);
+	}
+	XSRETURN(1);
+#line 1179 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA__addfilemap); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__addfilemap)
+{
+    dVAR; dXSARGS;
+    if (items != 2)
+       croak_xs_usage(cv,  "self, f");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	SV *	self = ST(0)
+;
+	PerlIO *	f = IoIFP(sv_2io(ST(1)))
+;
+#line 769 "SHA.xs"
+	SHA *state;
+	Off_t pos;
+	int n;
+#line 1203 "SHA.c"
+#line 773 "SHA.xs"
+	if (!f || (state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	if ((pos = PerlIO_tell(f)) < 0)
+		XSRETURN_UNDEF;
+	if ((n = shamapfd(state, PerlIO_fileno(f), pos)) == 0)
+		XSRETURN_UNDEF;
+	PerlIO_seek(f, 0, SEEK_END);
+	if (n < 0)
+		XSRETURN_NO;
+	XSRETURN(1);
+#line 1215 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA__addfilepipe); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__addfilepipe)
+{
+    dVAR; dXSARGS;
+    if (items != 4)
+       croak_xs_usage(cv,  "self, f, nbufs, bufsize");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	SV *	self = ST(0)
+;
+	PerlIO *	f = IoIFP(sv_2io(ST(1)))
+;
+	int	nbufs = (int)SvIV(ST(2))
+;
+	long	bufsize = (long)SvIV(ST(3))
+;
+#line 791 "SHA.xs"
+	SHA *state;
+	Off_t pos;
+	int n;
+#line 1243 "SHA.c"
+#line 795 "SHA.xs"
+	if (!f || (state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	if ((pos = PerlIO_tell(f)) < 0)
+		XSRETURN_UNDEF;
+	if ((n = shapipefd(state, PerlIO_fileno(f), pos, nbufs, bufsize)) == 0)
+		XSRETURN_UNDEF;
+	PerlIO_seek(f, 0, SEEK_END);
+	if (n < 0)
+		XSRETURN_NO;
+	XSRETURN(1);
+#line 1255 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA__async_submit); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__async_submit)
+{
+    dVAR; dXSARGS;
+    if (items != 4)
+       croak_xs_usage(cv,  "self, path, fd, pos");
+    {
+	SV *	self = ST(0)
+;
+	SV *	path = ST(1)
+;
+	int	fd = (int)SvIV(ST(2))
+;
+	IV	pos = (IV)SvIV(ST(3))
+;
+#line 813 "SHA.xs"
+	SHA *state;
+	SHAOWNER *o;
+	SHAJOB *j;
+	char *p = NULL;
+	STRLEN len = 0;
+#line 1283 "SHA.c"
+	SV *	RETVAL;
+#line 819 "SHA.xs"
+	if ((state = getSHA(self)) == NULL || (o = asyncself(aTHX)) == NULL)
+		XSRETURN_UNDEF;
+	if (SvOK(path))
+		p = SvPV(path, len);
+	if ((j = asyncjob(o, state, p, (size_t) len)) == NULL)
+		XSRETURN_UNDEF;
+	j->pos = (Off_t) pos;
+	if (p == NULL && (j->fd = dup(fd)) < 0) {
+		asyncfree(j);
+		XSRETURN_UNDEF;
+	}
+	if (!asyncsubmit(j)) {
+		asyncfree(j);
+		XSRETURN_UNDEF;
+	}
+	RETVAL = newSVuv((UV) j->id);
+#line 1302 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__async_reap); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__async_reap)
+{
+    dVAR; dXSARGS;
+    if (items != 0)
+       croak_xs_usage(cv,  "");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+#line 841 "SHA.xs"
+	SHAOWNER *o;
+	SHAJOB *j;
+#line 1322 "SHA.c"
+#line 844 "SHA.xs"
+	if ((o = asyncself(aTHX)) == NULL)
+		XSRETURN_EMPTY;
+	for (j = asyncreap(o); j != NULL; j = j->next)
+		XPUSHs(sv_2mortal(newSVuv((UV) j->id)));
+#line 1328 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA__async_finish); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__async_finish)
+{
+    dVAR; dXSARGS;
+    if (items != 2)
+       croak_xs_usage(cv,  "self, id");
+    {
+	SV *	self = ST(0)
+;
+	UV	id = (UV)SvUV(ST(1))
+;
+#line 854 "SHA.xs"
+	SHA *state;
+	SHAOWNER *o;
+	SHAJOB *j;
+#line 1350 "SHA.c"
+	SV *	RETVAL;
+#line 858 "SHA.xs"
+	if ((o = asyncself(aTHX)) == NULL ||
+		(j = asynctake(o, (ULNG) id)) == NULL)
+		XSRETURN_UNDEF;
+	if (j->err == 0 && (state = getSHA(self)) != NULL)
+		Copy(&j->sha, state, 1, SHA);
+	RETVAL = newSViv(j->err);
+	asyncfree(j);
+#line 1360 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA_async_fd); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_async_fd)
+{
+    dVAR; dXSARGS;
+    if (items != 0)
+       croak_xs_usage(cv,  "");
+    {
+#line 871 "SHA.xs"
+	SHAOWNER *o;
+	int fd;
+#line 1378 "SHA.c"
+	SV *	RETVAL;
+#line 874 "SHA.xs"
+	if ((o = asyncself(aTHX)) == NULL || (fd = asyncfd(o)) < 0)
+		XSRETURN_UNDEF;
+	RETVAL = newSViv(fd);
+#line 1384 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA_async_threads); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA_async_threads)
+{
+    dVAR; dXSARGS;
+    if (items < 0 || items > 1)
+       croak_xs_usage(cv,  "n = 0");
+    {
+	int	n;
+	int	RETVAL;
+	dXSTARG;
+
+	if (items < 1)
+	    n = 0;
+	else {
+	    n = (int)SvIV(ST(0))
+;
+	}
+#line 884 "SHA.xs"
+	RETVAL = asyncmax(n);
+#line 1411 "SHA.c"
+	XSprePUSH;
+	PUSHi((IV)RETVAL);
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__digestfiles); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__digestfiles)
+{
+    dVAR; dXSARGS;
+    if (items < 3 || items > 4)
+       croak_xs_usage(cv,  "alg, paths, jobs, format = 0");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	int	alg = (int)SvIV(ST(0))
+;
+	SV *	paths = ST(1)
+;
+	int	jobs = (int)SvIV(ST(2))
+;
+	int	format;
+#line 895 "SHA.xs"
+	int i, n;
+	AV *av, *digests, *errs;
+	SV **svp;
+	SHA sha;
+	char **names;
+	UCHR *buf, *state;
+	int *err;
+#line 1443 "SHA.c"
+
+	if (items < 4)
+	    format = 0;
+	else {
+	    format = (int)SvIV(ST(3))
+;
+	}
+#line 903 "SHA.xs"
+	if (!SvROK(paths) || SvTYPE(SvRV(paths)) != SVt_PVAV)
+		XSRETURN_EMPTY;
+	if (!shainit(&sha, alg))
+		XSRETURN_EMPTY;
+	av = (AV *) SvRV(paths);
+	n = (int) (av_len(av) + 1);
+	Newx(names, n + 1, char *);
+	SAVEFREEPV(names);
+	Newx(buf, (n + 1) * SHA_MAX_STATE_LEN, UCHR);
+	SAVEFREEPV(buf);
+	Newx(err, n + 1, int);
+	SAVEFREEPV(err);
+	for (i = 0; i < n; i++) {
+		svp = av_fetch(av, i, 0);
+		names[i] = svp ? SvPV_nolen(*svp) : (char *) "";
+	}
+	shafiles(alg, names, n, jobs, buf, err);
+	digests = newAV();
+	errs = newAV();
+	for (i = 0; i < n; i++) {
+		av_push(errs, newSViv(err[i]));
+		state = buf + i * SHA_MAX_STATE_LEN;
+		if (err[i])
+			av_push(digests, newSV(0));
+		else if (format == 3)
+			av_push(digests, newSVpv((char *) state,
+				alg <= SHA256 ? 116 : 212));
+		else {
+			shaunpack(&sha, state, alg <= SHA256 ? 116 : 212);
+			shafinish(&sha);
+			av_push(digests, digestsv(&sha, format));
+		}
+	}
+	EXTEND(SP, 2);
+	PUSHs(sv_2mortal(newRV_noinc((SV *) digests)));
+	PUSHs(sv_2mortal(newRV_noinc((SV *) errs)));
+#line 1488 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA__statedigest); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__statedigest)
+{
+    dVAR; dXSARGS;
+    if (items < 2 || items > 3)
+       croak_xs_usage(cv,  "alg, packed_state, format = 1");
+    {
+	int	alg = (int)SvIV(ST(0))
+;
+	SV *	packed_state = ST(1)
+;
+	int	format;
+#line 946 "SHA.xs"
+	SHA sha;
+	STRLEN len;
+	UCHR *data;
+#line 1511 "SHA.c"
+	SV *	RETVAL;
+
+	if (items < 3)
+	    format = 1;
+	else {
+	    format = (int)SvIV(ST(2))
+;
+	}
+#line 950 "SHA.xs"
+	if (!shainit(&sha, alg))
+		XSRETURN_UNDEF;
+	data = (UCHR *) SvPVbyte(packed_state, len);
+	if (len > SHA_MAX_STATE_LEN || !shaunpack(&sha, data, (UINT) len))
+		XSRETURN_UNDEF;
+	shafinish(&sha);
+	RETVAL = digestsv(&sha, format);
+#line 1528 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__pbkdf2); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__pbkdf2)
+{
+    dVAR; dXSARGS;
+    if (items != 5)
+       croak_xs_usage(cv,  "alg, password, salt, iterations, dklen");
+    {
+	int	alg = (int)SvIV(ST(0))
+;
+	SV *	password = ST(1)
+;
+	SV *	salt = ST(2)
+;
+	UV	iterations = (UV)SvUV(ST(3))
+;
+	UV	dklen = (UV)SvUV(ST(4))
+;
+#line 968 "SHA.xs"
+	UCHR *pw, *sp;
+	STRLEN pwlen, saltlen;
+#line 1556 "SHA.c"
+	SV *	RETVAL;
+#line 971 "SHA.xs"
+	pw = (UCHR *) SvPVbyte(password, pwlen);
+	sp = (UCHR *) SvPVbyte(salt, saltlen);
+	if (iterations < 1 || iterations > SHA32_MAX || (STRLEN) dklen != dklen)
+		XSRETURN_UNDEF;
+	RETVAL = newSV(dklen + 1);
+	SvPOK_only(RETVAL);
+	if (!pbkdf2(alg, pw, (UINT) pwlen, sp, saltlen, (ULNG) iterations,
+		(UCHR *) SvPVX(RETVAL), (size_t) dklen)) {
+		SvREFCNT_dec(RETVAL);
+		XSRETURN_UNDEF;
+	}
+	SvCUR_set(RETVAL, dklen);
+	*SvEND(RETVAL) = '\0';
+#line 1572 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__hkdfextract); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__hkdfextract)
+{
+    dVAR; dXSARGS;
+    if (items != 3)
+       croak_xs_usage(cv,  "alg, salt, ikm");
+    {
+	int	alg = (int)SvIV(ST(0))
+;
+	SV *	salt = ST(1)
+;
+	SV *	ikm = ST(2)
+;
+#line 993 "SHA.xs"
+	UCHR *sp, *kp;
+	STRLEN saltlen, ikmlen;
+	UINT len;
+	UCHR prk[SHA_MAX_DIGEST_BITS/8];
+#line 1598 "SHA.c"
+	SV *	RETVAL;
+#line 998 "SHA.xs"
+	sp = (UCHR *) SvPVbyte(salt, saltlen);
+	kp = (UCHR *) SvPVbyte(ikm, ikmlen);
+	if ((len = hkdfextract(alg, sp, (UINT) saltlen, kp, ikmlen, prk)) == 0)
+		XSRETURN_UNDEF;
+	RETVAL = newSVpv((char *) prk, len);
+	Zero(prk, sizeof(prk), UCHR);
+#line 1607 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__hkdfexpand); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__hkdfexpand)
+{
+    dVAR; dXSARGS;
+    if (items != 4)
+       croak_xs_usage(cv,  "alg, prk, info, len");
+    {
+	int	alg = (int)SvIV(ST(0))
+;
+	SV *	prk = ST(1)
+;
+	SV *	info = ST(2)
+;
+	UV	len = (UV)SvUV(ST(3))
+;
+#line 1014 "SHA.xs"
+	UCHR *kp, *ip;
+	STRLEN prklen, infolen;
+#line 1633 "SHA.c"
+	SV *	RETVAL;
+#line 1017 "SHA.xs"
+	kp = (UCHR *) SvPVbyte(prk, prklen);
+	ip = (UCHR *) SvPVbyte(info, infolen);
+	if (len > 255 * (SHA_MAX_DIGEST_BITS/8))
+		XSRETURN_UNDEF;
+	RETVAL = newSV(len + 1);
+	SvPOK_only(RETVAL);
+	if (!hkdfexpand(alg, kp, (UINT) prklen, ip, infolen,
+		(UCHR *) SvPVX(RETVAL), (size_t) len)) {
+		SvREFCNT_dec(RETVAL);
+		XSRETURN_UNDEF;
+	}
+	SvCUR_set(RETVAL, len);
+	*SvEND(RETVAL) = '\0';
+#line 1649 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__addfileuniv); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__addfileuniv)
+{
+    dVAR; dXSARGS;
+    if (items < 2 || items > 3)
+       croak_xs_usage(cv,  "self, f, portable = 0");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	SV *	self = ST(0)
+;
+	PerlIO *	f = IoIFP(sv_2io(ST(1)))
+;
+	int	portable;
+#line 1039 "SHA.xs"
+	int n;
+	UINT held = 0;
+	size_t len;
+	UCHR *p;
+	UCHR *in;
+	SHA *state;
+#line 1678 "SHA.c"
+
+	if (items < 3)
+	    portable = 0;
+	else {
+	    portable = (int)SvIV(ST(2))
+;
+	}
+#line 1046 "SHA.xs"
+	if (!f || (state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	Newx(in, 2+SHA_READ_SIZE, UCHR);	/* too big for thread stacks */
+	while ((n = PerlIO_read(f, in+2, SHA_READ_SIZE)) > 0) {
+		SHA_STAT(state, reads, 1);
+		SHA_STAT(state, readbytes, n);
+		in[0] = in[1] = '\015';	/* CRs held from last read */
+		p = in + 2 - held;
+		len = univnl(p, held + (size_t) n, portable, 1, &held);
+		shawritebytes(p, len, state);
+	}
+	if (held) {
+		in[0] = in[1] = '\015';
+		p = in + 2 - held;
+		len = univnl(p, held, portable, 0, &held);
+		shawritebytes(p, len, state);
+	}
+	Safefree(in);
+	XSRETURN(1);
+#line 1706 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA__HMAC__new); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__HMAC__new)
+{
+    dVAR; dXSARGS;
+    if (items != 3)
+       croak_xs_usage(cv,  "classname, alg, key");
+    {
+	char *	classname = (char *)SvPV_nolen(ST(0))
+;
+	int	alg = (int)SvIV(ST(1))
+;
+	SV *	key = ST(2)
+;
+#line 1076 "SHA.xs"
+	HMAC *hmac;
+	UCHR *data;
+	STRLEN len;
+#line 1730 "SHA.c"
+	SV *	RETVAL;
+#line 1080 "SHA.xs"
+	data = (UCHR *) SvPVbyte(key, len);
+	Newxz(hmac, 1, HMAC);
+	if (hmacinit(hmac, alg, data, (UINT) len) == NULL) {
+		Safefree(hmac);
+		XSRETURN_UNDEF;
+	}
+	RETVAL = newSV(0);
+	sv_setref_pv(RETVAL, classname, (void *) hmac);
+	SvREADONLY_on(SvRV(RETVAL));
+#line 1742 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__HMAC_DESTROY); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__HMAC_DESTROY)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    {
+	SV *	self = ST(0)
+;
+#line 1096 "SHA.xs"
+	HMAC *hmac;
+#line 1761 "SHA.c"
+#line 1098 "SHA.xs"
+	if ((hmac = getHMAC(self)) != NULL) {
+		Zero(hmac, 1, HMAC);
+		Safefree(hmac);
+	}
+#line 1767 "SHA.c"
+    }
+    XSRETURN_EMPTY;
+}
+
+
+XS_EUPXS(XS_Digest__SHA__HMAC_algorithm); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__HMAC_algorithm)
+{
+    dVAR; dXSARGS;
+    dXSI32;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    {
+	SV *	self = ST(0)
+;
+#line 1110 "SHA.xs"
+	HMAC *hmac;
+#line 1785 "SHA.c"
+	int	RETVAL;
+	dXSTARG;
+#line 1112 "SHA.xs"
+	if ((hmac = getHMAC(self)) == NULL)
+		XSRETURN_UNDEF;
+	RETVAL = ix ? (int) hmac->digestlen << 3 : hmac->osha.alg;
+#line 1792 "SHA.c"
+	XSprePUSH;
+	PUSHi((IV)RETVAL);
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__HMAC_mac); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__HMAC_mac)
+{
+    dVAR; dXSARGS;
+    dXSI32;
+    if (items < 1)
+       croak_xs_usage(cv,  "self, ...");
+    {
+	SV *	self = ST(0)
+;
+#line 1126 "SHA.xs"
+	int i;
+	UCHR *data;
+	STRLEN len;
+	HMAC *key;
+	HMAC hmac;
+#line 1816 "SHA.c"
+	SV *	RETVAL;
+#line 1132 "SHA.xs"
+	if ((key = getHMAC(self)) == NULL)
+		XSRETURN_UNDEF;
+	Copy(&key->isha, &hmac.isha, 1, SHA);
+	Copy(&key->osha, &hmac.osha, 1, SHA);
+	hmac.digestlen = key->digestlen;
+	for (i = 1; i < items; i++) {
+		data = (UCHR *) (SvPVbyte(ST(i), len));
+		hmacwritebytes(data, len, &hmac);
+	}
+	hmacfinish(&hmac);
+	RETVAL = digestsv(&hmac.osha, ix);
+	Zero(&hmac, 1, HMAC);
+#line 1831 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__Tree__new); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__Tree__new)
+{
+    dVAR; dXSARGS;
+    if (items != 4)
+       croak_xs_usage(cv,  "classname, alg, leafsize, jobs");
+    {
+	char *	classname = (char *)SvPV_nolen(ST(0))
+;
+	int	alg = (int)SvIV(ST(1))
+;
+	UV	leafsize = (UV)SvUV(ST(2))
+;
+	int	jobs = (int)SvIV(ST(3))
+;
+#line 1158 "SHA.xs"
+	SHATREE *tree;
+#line 1856 "SHA.c"
+	SV *	RETVAL;
+#line 1160 "SHA.xs"
+	Newx(tree, 1, SHATREE);
+	if (leafsize > SHA_TREE_MAX_LEAF ||
+		treeinit(tree, alg, (ULNG) leafsize, jobs) == NULL) {
+		Safefree(tree);
+		XSRETURN_UNDEF;
+	}
+	RETVAL = newSV(0);
+	sv_setref_pv(RETVAL, classname, (void *) tree);
+	SvREADONLY_on(SvRV(RETVAL));
+#line 1868 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__Tree_DESTROY); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__Tree_DESTROY)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    {
+	SV *	self = ST(0)
+;
+#line 1176 "SHA.xs"
+	SHATREE *tree;
+#line 1887 "SHA.c"
+#line 1178 "SHA.xs"
+	if ((tree = getTree(self)) != NULL)
+		Safefree(tree);
+#line 1891 "SHA.c"
+    }
+    XSRETURN_EMPTY;
+}
+
+
+XS_EUPXS(XS_Digest__SHA__Tree_algorithm); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__Tree_algorithm)
+{
+    dVAR; dXSARGS;
+    dXSI32;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    {
+	SV *	self = ST(0)
+;
+#line 1190 "SHA.xs"
+	SHATREE *tree;
+#line 1909 "SHA.c"
+	UV	RETVAL;
+	dXSTARG;
+#line 1192 "SHA.xs"
+	if ((tree = getTree(self)) == NULL)
+		XSRETURN_UNDEF;
+	if (ix == 0)
+		RETVAL = tree->alg;
+	else if (ix == 1)
+		RETVAL = tree->result.digestlen << 3;
+	else if (ix == 2)
+		RETVAL = tree->leafsize;
+	else
+		RETVAL = tree->nthreads;
+#line 1923 "SHA.c"
+	XSprePUSH;
+	PUSHu((UV)RETVAL);
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__Tree_add); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__Tree_add)
+{
+    dVAR; dXSARGS;
+    if (items < 1)
+       croak_xs_usage(cv,  "self, ...");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	SV *	self = ST(0)
+;
+#line 1209 "SHA.xs"
+	int i;
+	UCHR *data;
+	STRLEN len;
+	SHATREE *tree;
+#line 1947 "SHA.c"
+#line 1214 "SHA.xs"
+	if ((tree = getTree(self)) == NULL)
+		XSRETURN_UNDEF;
+	for (i = 1; i < items; i++) {
+		data = (UCHR *) (SvPVbyte(ST(i), len));
+		treewrite(tree, data, len);
+	}
+	XSRETURN(1);
+#line 1956 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA__Tree_reset); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__Tree_reset)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	SV *	self = ST(0)
+;
+#line 1226 "SHA.xs"
+	SHATREE *tree;
+#line 1976 "SHA.c"
+#line 1228 "SHA.xs"
+	if ((tree = getTree(self)) == NULL)
+		XSRETURN_UNDEF;
+	treereset(tree);
+	XSRETURN(1);
+#line 1982 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA__Tree_digest); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__Tree_digest)
+{
+    dVAR; dXSARGS;
+    dXSI32;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    {
+	SV *	self = ST(0)
+;
+#line 1241 "SHA.xs"
+	SHATREE *tree;
+#line 2001 "SHA.c"
+	SV *	RETVAL;
+#line 1243 "SHA.xs"
+	if ((tree = getTree(self)) == NULL)
+		XSRETURN_UNDEF;
+	treefinish(tree);
+	RETVAL = digestsv(&tree->result, ix);
+#line 2008 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__Tree__addfilemap); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__Tree__addfilemap)
+{
+    dVAR; dXSARGS;
+    if (items != 2)
+       croak_xs_usage(cv,  "self, f");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	SV *	self = ST(0)
+;
+	PerlIO *	f = IoIFP(sv_2io(ST(1)))
+;
+#line 1255 "SHA.xs"
+	SHATREE *tree;
+	Off_t pos;
+	int n;
+#line 2033 "SHA.c"
+#line 1259 "SHA.xs"
+	if (!f || (tree = getTree(self)) == NULL)
+		XSRETURN_UNDEF;
+	if ((pos = PerlIO_tell(f)) < 0)
+		XSRETURN_UNDEF;
+	if ((n = treemapfd(tree, PerlIO_fileno(f), pos)) == 0)
+		XSRETURN_UNDEF;
+	PerlIO_seek(f, 0, SEEK_END);
+	if (n < 0)
+		XSRETURN_NO;
+	XSRETURN(1);
+#line 2045 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA__CDC__new); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__CDC__new)
+{
+    dVAR; dXSARGS;
+    if (items != 6)
+       croak_xs_usage(cv,  "classname, alg, minsize, avgsize, maxsize, format");
+    {
+	char *	classname = (char *)SvPV_nolen(ST(0))
+;
+	int	alg = (int)SvIV(ST(1))
+;
+	UV	minsize = (UV)SvUV(ST(2))
+;
+	UV	avgsize = (UV)SvUV(ST(3))
+;
+	UV	maxsize = (UV)SvUV(ST(4))
+;
+	int	format = (int)SvIV(ST(5))
+;
+#line 1283 "SHA.xs"
+	SHACDC *cdc;
+#line 2073 "SHA.c"
+	SV *	RETVAL;
+#line 1285 "SHA.xs"
+	Newx(cdc, 1, SHACDC);
+	if (maxsize > SHA_CDC_MAX_LIMIT || cdcinit(cdc, alg, (UINT) minsize,
+		(UINT) avgsize, (UINT) maxsize) == NULL) {
+		Safefree(cdc);
+		XSRETURN_UNDEF;
+	}
+	cdc->format = format;
+	RETVAL = newSV(0);
+	sv_setref_pv(RETVAL, classname, (void *) cdc);
+	SvREADONLY_on(SvRV(RETVAL));
+#line 2086 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__CDC_DESTROY); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__CDC_DESTROY)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    {
+	SV *	self = ST(0)
+;
+#line 1302 "SHA.xs"
+	SHACDC *cdc;
+#line 2105 "SHA.c"
+#line 1304 "SHA.xs"
+	if ((cdc = getCDC(self)) != NULL)
+		Safefree(cdc);
+#line 2109 "SHA.c"
+    }
+    XSRETURN_EMPTY;
+}
+
+
+XS_EUPXS(XS_Digest__SHA__CDC_algorithm); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__CDC_algorithm)
+{
+    dVAR; dXSARGS;
+    dXSI32;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    {
+	SV *	self = ST(0)
+;
+#line 1317 "SHA.xs"
+	SHACDC *cdc;
+#line 2127 "SHA.c"
+	UV	RETVAL;
+	dXSTARG;
+#line 1319 "SHA.xs"
+	if ((cdc = getCDC(self)) == NULL)
+		XSRETURN_UNDEF;
+	if (ix == 0)
+		RETVAL = cdc->alg;
+	else if (ix == 1)
+		RETVAL = cdc->sha.digestlen << 3;
+	else
+		RETVAL = ix == 2 ? cdc->minsize :
+			(ix == 3 ? cdc->avgsize : cdc->maxsize);
+#line 2140 "SHA.c"
+	XSprePUSH;
+	PUSHu((UV)RETVAL);
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__CDC_add); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__CDC_add)
+{
+    dVAR; dXSARGS;
+    if (items < 1)
+       croak_xs_usage(cv,  "self, ...");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	SV *	self = ST(0)
+;
+#line 1335 "SHA.xs"
+	int i, done;
+	UCHR *data;
+	STRLEN len;
+	size_t n;
+	SSize_t j, nchunks;
+	SHACDC *cdc;
+	AV *chunks;
+#line 2167 "SHA.c"
+#line 1343 "SHA.xs"
+	if ((cdc = getCDC(self)) == NULL)
+		XSRETURN_EMPTY;
+	chunks = (AV *) sv_2mortal((SV *) newAV());
+	for (i = 1; i < items; i++) {
+		data = (UCHR *) (SvPVbyte(ST(i), len));
+		while (len > 0) {
+			n = cdcwrite(cdc, data, len, &done);
+			data += n;
+			len -= n;
+			if (done)
+				av_push(chunks, cdcchunk(cdc));
+		}
+	}
+	nchunks = av_len(chunks) + 1;
+	EXTEND(SP, nchunks);
+	for (j = 0; j < nchunks; j++)
+		PUSHs(sv_2mortal(SvREFCNT_inc(*av_fetch(chunks, j, 0))));
+#line 2186 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA__CDC_finish); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__CDC_finish)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	SV *	self = ST(0)
+;
+#line 1365 "SHA.xs"
+	SHACDC *cdc;
+#line 2206 "SHA.c"
+#line 1367 "SHA.xs"
+	if ((cdc = getCDC(self)) == NULL)
+		XSRETURN_EMPTY;
+	if (cdc->len > 0)
+		XPUSHs(sv_2mortal(cdcchunk(cdc)));
+	cdcreset(cdc);
+#line 2213 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA__CDC_reset); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__CDC_reset)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    PERL_UNUSED_VAR(ax); /* -Wall */
+    SP -= items;
+    {
+	SV *	self = ST(0)
+;
+#line 1377 "SHA.xs"
+	SHACDC *cdc;
+#line 2233 "SHA.c"
+#line 1379 "SHA.xs"
+	if ((cdc = getCDC(self)) == NULL)
+		XSRETURN_UNDEF;
+	cdcreset(cdc);
+	XSRETURN(1);
+#line 2239 "SHA.c"
+	PUTBACK;
+	return;
+    }
+}
+
+
+XS_EUPXS(XS_Digest__SHA__Cache__open); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__Cache__open)
+{
+    dVAR; dXSARGS;
+    if (items < 3 || items > 4)
+       croak_xs_usage(cv,  "classname, file, rebuild, racy = -1");
+    {
+	char *	classname = (char *)SvPV_nolen(ST(0))
+;
+	char *	file = (char *)SvPV_nolen(ST(1))
+;
+	int	rebuild = (int)SvIV(ST(2))
+;
+	int	racy;
+#line 1395 "SHA.xs"
+#ifdef SHA_CACHE
+	SHACACHE *cache;
+#endif
+#line 2264 "SHA.c"
+	SV *	RETVAL;
+
+	if (items < 4)
+	    racy = -1;
+	else {
+	    racy = (int)SvIV(ST(3))
+;
+	}
+#line 1399 "SHA.xs"
+#ifdef SHA_CACHE
+	Newxz(cache, 1, SHACACHE);
+	if (!cacheopen(cache, file, rebuild)) {
+		Safefree(cache);
+		XSRETURN_UNDEF;
+	}
+	if (racy >= 0)
+		cache->racy = (W32) racy;
+	RETVAL = newSV(0);
+	sv_setref_pv(RETVAL, classname, (void *) cache);
+	SvREADONLY_on(SvRV(RETVAL));
+#else
+	PERL_UNUSED_VAR(classname);
+	PERL_UNUSED_VAR(file);
+	PERL_UNUSED_VAR(rebuild);
+	PERL_UNUSED_VAR(racy);
+	errno = ENOSYS;
+	XSRETURN_UNDEF;
+#endif
+#line 2293 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__Cache_DESTROY); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__Cache_DESTROY)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "self");
+    {
+	SV *	self = ST(0)
+;
+#line 1425 "SHA.xs"
+#ifdef SHA_CACHE
+	SHACACHE *cache;
+#endif
+#line 2314 "SHA.c"
+#line 1429 "SHA.xs"
+#ifdef SHA_CACHE
+	if ((cache = getCache(self)) != NULL) {
+		cacheclose(cache);
+		Safefree(cache);
+	}
+#else
+	PERL_UNUSED_VAR(self);
+#endif
+#line 2324 "SHA.c"
+    }
+    XSRETURN_EMPTY;
+}
+
+
+XS_EUPXS(XS_Digest__SHA__Cache__statkey); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__Cache__statkey)
+{
+    dVAR; dXSARGS;
+    if (items != 1)
+       croak_xs_usage(cv,  "f");
+    {
+	SV *	f = ST(0)
+;
+#line 1442 "SHA.xs"
+	struct stat st;
+	UCHR key[CACHE_KEY_LEN];
+	PerlIO *fp;
+	int ok;
+#line 2344 "SHA.c"
+	SV *	RETVAL;
+#line 1447 "SHA.xs"
+	if (SvTYPE(f) == SVt_PVGV || (SvROK(f) &&
+		(SvTYPE(SvRV(f)) == SVt_PVGV || SvTYPE(SvRV(f)) == SVt_PVIO))) {
+		fp = IoIFP(sv_2io(f));
+		ok = fp != NULL && fstat(PerlIO_fileno(fp), &st) == 0;
+	}
+	else
+		ok = SvOK(f) && stat(SvPV_nolen(f), &st) == 0;
+	if (!ok || !cachekey(&st, key))
+		XSRETURN_UNDEF;
+	RETVAL = newSVpv((char *) key, CACHE_KEY_LEN);
+#line 2357 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__Cache_get); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__Cache_get)
+{
+    dVAR; dXSARGS;
+    if (items != 4)
+       croak_xs_usage(cv,  "self, key, alg, mode");
+    {
+	SV *	self = ST(0)
+;
+	SV *	key = ST(1)
+;
+	int	alg = (int)SvIV(ST(2))
+;
+	char *	mode = (char *)SvPV_nolen(ST(3))
+;
+#line 1467 "SHA.xs"
+#ifdef SHA_CACHE
+	SHACACHE *cache;
+	UCHR *k;
+	STRLEN len;
+	UINT n;
+	UCHR state[SHA_MAX_STATE_LEN];
+#endif
+#line 2388 "SHA.c"
+	SV *	RETVAL;
+#line 1475 "SHA.xs"
+#ifdef SHA_CACHE
+	if ((cache = getCache(self)) == NULL)
+		XSRETURN_UNDEF;
+	k = (UCHR *) SvPVbyte(key, len);
+	if (len != CACHE_KEY_LEN)
+		XSRETURN_UNDEF;
+	if ((n = cacheget(cache, k, alg, *mode, state)) == 0)
+		XSRETURN_UNDEF;
+	RETVAL = newSVpv((char *) state, n);
+#else
+	PERL_UNUSED_VAR(self);
+	PERL_UNUSED_VAR(key);
+	PERL_UNUSED_VAR(alg);
+	PERL_UNUSED_VAR(mode);
+	XSRETURN_UNDEF;
+#endif
+#line 2407 "SHA.c"
+	RETVAL = sv_2mortal(RETVAL);
+	ST(0) = RETVAL;
+    }
+    XSRETURN(1);
+}
+
+
+XS_EUPXS(XS_Digest__SHA__Cache_put); /* prototype to pass -Wmissing-prototypes */
+XS_EUPXS(XS_Digest__SHA__Cache_put)
+{
+    dVAR; dXSARGS;
+    if (items != 5)
+       croak_xs_usage(cv,  "self, key, alg, mode, state");
+    {
+	SV *	self = ST(0)
+;
+	SV *	key = ST(1)
+;
+	int	alg = (int)SvIV(ST(2))
+;
+	char *	mode = (char *)SvPV_nolen(ST(3))
+;
+	SV *	state = ST(4)
+;
+#line 1502 "SHA.xs"
+#ifdef SHA_CACHE
+	SHACACHE *cache;
+	UCHR *k, *data;
+	STRLEN klen, len;
+#endif
+#line 2438 "SHA.c"
+	int	RETVAL;
+	dXSTARG;
+#line 1508 "SHA.xs"
+	RETVAL = 0;
+#ifdef SHA_CACHE
+	if ((cache = getCache(self)) == NULL)
+		XSRETURN_UNDEF;
+	k = (UCHR *) SvPVbyte(key, klen);
+	data = (UCHR *) SvPVbyte(state, len);
+	if (klen == CACHE_KEY_LEN && len <= SHA_MAX_STATE_LEN)
+		RETVAL = cacheput(cache, k, alg, *mode, data, (UINT) len);
+#else
+	PERL_UNUSED_VAR(self);
+	PERL_UNUSED_VAR(key);
+	PERL_UNUSED_VAR(alg);
+	PERL_UNUSED_VAR(mode);
+	PERL_UNUSED_VAR(state);
+#endif
+#line 2457 "SHA.c"
+	XSprePUSH;
+	PUSHi((IV)RETVAL);
+    }
+    XSRETURN(1);
+}
+
+#ifdef __cplusplus
+extern "C"
+#endif
+XS_EXTERNAL(boot_Digest__SHA); /* prototype to pass -Wmissing-prototypes */
+XS_EXTERNAL(boot_Digest__SHA)
+{
+#if PERL_VERSION_LE(5, 21, 5)
+    dVAR; dXSARGS;
+#else
+    dVAR; dXSBOOTARGSXSAPIVERCHK;
+#endif
+#if PERL_VERSION_LE(5, 8, 999) /* PERL_VERSION_LT is 5.33+ */
+    char* file = __FILE__;
+#else
+    const char* file = __FILE__;
+#endif
+
+    PERL_UNUSED_VAR(file);
+
+    PERL_UNUSED_VAR(cv); /* -W */
+    PERL_UNUSED_VAR(items); /* -W */
+#if PERL_VERSION_LE(5, 21, 5)
+    XS_VERSION_BOOTCHECK;
+#  ifdef XS_APIVERSION_BOOTCHECK
+    XS_APIVERSION_BOOTCHECK;
+#  endif
+#endif
+
+        (void)newXSproto_portable("Digest::SHA::shadispatch", XS_Digest__SHA_shadispatch, file, "$");
+        (void)newXSproto_portable("Digest::SHA::_cpuid", XS_Digest__SHA__cpuid, file, "");
+        (void)newXSproto_portable("Digest::SHA::_cycles", XS_Digest__SHA__cycles, file, "");
+        (void)newXSproto_portable("Digest::SHA::shainit", XS_Digest__SHA_shainit, file, "$$");
+        (void)newXSproto_portable("Digest::SHA::sharewind", XS_Digest__SHA_sharewind, file, "$");
+        (void)newXSproto_portable("Digest::SHA::shawrite", XS_Digest__SHA_shawrite, file, "$$$");
+        (void)newXSproto_portable("Digest::SHA::newSHA", XS_Digest__SHA_newSHA, file, "$$");
+        (void)newXSproto_portable("Digest::SHA::clone", XS_Digest__SHA_clone, file, "$");
+        (void)newXSproto_portable("Digest::SHA::DESTROY", XS_Digest__SHA_DESTROY, file, "$");
+        cv = newXSproto_portable("Digest::SHA::sha1", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 0;
+        cv = newXSproto_portable("Digest::SHA::sha1_base64", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 2;
+        cv = newXSproto_portable("Digest::SHA::sha1_hex", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 1;
+        cv = newXSproto_portable("Digest::SHA::sha224", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 3;
+        cv = newXSproto_portable("Digest::SHA::sha224_base64", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 5;
+        cv = newXSproto_portable("Digest::SHA::sha224_hex", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 4;
+        cv = newXSproto_portable("Digest::SHA::sha256", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 6;
+        cv = newXSproto_portable("Digest::SHA::sha256_base64", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 8;
+        cv = newXSproto_portable("Digest::SHA::sha256_hex", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 7;
+        cv = newXSproto_portable("Digest::SHA::sha384", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 9;
+        cv = newXSproto_portable("Digest::SHA::sha384_base64", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 11;
+        cv = newXSproto_portable("Digest::SHA::sha384_hex", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 10;
+        cv = newXSproto_portable("Digest::SHA::sha512", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 12;
+        cv = newXSproto_portable("Digest::SHA::sha512224", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 15;
+        cv = newXSproto_portable("Digest::SHA::sha512224_base64", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 17;
+        cv = newXSproto_portable("Digest::SHA::sha512224_hex", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 16;
+        cv = newXSproto_portable("Digest::SHA::sha512256", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 18;
+        cv = newXSproto_portable("Digest::SHA::sha512256_base64", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 20;
+        cv = newXSproto_portable("Digest::SHA::sha512256_hex", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 19;
+        cv = newXSproto_portable("Digest::SHA::sha512_base64", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 14;
+        cv = newXSproto_portable("Digest::SHA::sha512_hex", XS_Digest__SHA_sha1, file, ";@");
+        XSANY.any_i32 = 13;
+        cv = newXSproto_portable("Digest::SHA::sha1_base64_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 2;
+        cv = newXSproto_portable("Digest::SHA::sha1_hex_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 1;
+        cv = newXSproto_portable("Digest::SHA::sha1_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 0;
+        cv = newXSproto_portable("Digest::SHA::sha224_base64_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 5;
+        cv = newXSproto_portable("Digest::SHA::sha224_hex_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 4;
+        cv = newXSproto_portable("Digest::SHA::sha224_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 3;
+        cv = newXSproto_portable("Digest::SHA::sha256_base64_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 8;
+        cv = newXSproto_portable("Digest::SHA::sha256_hex_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 7;
+        cv = newXSproto_portable("Digest::SHA::sha256_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 6;
+        cv = newXSproto_portable("Digest::SHA::sha384_base64_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 11;
+        cv = newXSproto_portable("Digest::SHA::sha384_hex_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 10;
+        cv = newXSproto_portable("Digest::SHA::sha384_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 9;
+        cv = newXSproto_portable("Digest::SHA::sha512224_base64_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 17;
+        cv = newXSproto_portable("Digest::SHA::sha512224_hex_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 16;
+        cv = newXSproto_portable("Digest::SHA::sha512224_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 15;
+        cv = newXSproto_portable("Digest::SHA::sha512256_base64_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 20;
+        cv = newXSproto_portable("Digest::SHA::sha512256_hex_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 19;
+        cv = newXSproto_portable("Digest::SHA::sha512256_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 18;
+        cv = newXSproto_portable("Digest::SHA::sha512_base64_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 14;
+        cv = newXSproto_portable("Digest::SHA::sha512_hex_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 13;
+        cv = newXSproto_portable("Digest::SHA::sha512_many", XS_Digest__SHA_sha1_many, file, "$");
+        XSANY.any_i32 = 12;
+        cv = newXSproto_portable("Digest::SHA::sha1_base64_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 2;
+        cv = newXSproto_portable("Digest::SHA::sha1_hex_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 1;
+        cv = newXSproto_portable("Digest::SHA::sha1_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 0;
+        cv = newXSproto_portable("Digest::SHA::sha224_base64_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 5;
+        cv = newXSproto_portable("Digest::SHA::sha224_hex_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 4;
+        cv = newXSproto_portable("Digest::SHA::sha224_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 3;
+        cv = newXSproto_portable("Digest::SHA::sha256_base64_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 8;
+        cv = newXSproto_portable("Digest::SHA::sha256_hex_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 7;
+        cv = newXSproto_portable("Digest::SHA::sha256_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 6;
+        cv = newXSproto_portable("Digest::SHA::sha384_base64_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 11;
+        cv = newXSproto_portable("Digest::SHA::sha384_hex_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 10;
+        cv = newXSproto_portable("Digest::SHA::sha384_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 9;
+        cv = newXSproto_portable("Digest::SHA::sha512224_base64_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 17;
+        cv = newXSproto_portable("Digest::SHA::sha512224_hex_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 16;
+        cv = newXSproto_portable("Digest::SHA::sha512224_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 15;
+        cv = newXSproto_portable("Digest::SHA::sha512256_base64_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 20;
+        cv = newXSproto_portable("Digest::SHA::sha512256_hex_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 19;
+        cv = newXSproto_portable("Digest::SHA::sha512256_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 18;
+        cv = newXSproto_portable("Digest::SHA::sha512_base64_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 14;
+        cv = newXSproto_portable("Digest::SHA::sha512_hex_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 13;
+        cv = newXSproto_portable("Digest::SHA::sha512_into", XS_Digest__SHA_sha1_into, file, "$;@");
+        XSANY.any_i32 = 12;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha1", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 0;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha1_base64", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 2;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha1_hex", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 1;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha224", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 3;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha224_base64", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 5;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha224_hex", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 4;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha256", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 6;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha256_base64", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 8;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha256_hex", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 7;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha384", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 9;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha384_base64", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 11;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha384_hex", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 10;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha512", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 12;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha512224", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 15;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha512224_base64", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 17;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha512224_hex", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 16;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha512256", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 18;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha512256_base64", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 20;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha512256_hex", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 19;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha512_base64", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 14;
+        cv = newXSproto_portable("Digest::SHA::hmac_sha512_hex", XS_Digest__SHA_hmac_sha1, file, ";@");
+        XSANY.any_i32 = 13;
+        cv = newXSproto_portable("Digest::SHA::algorithm", XS_Digest__SHA_hashsize, file, "$");
+        XSANY.any_i32 = 1;
+        cv = newXSproto_portable("Digest::SHA::hashsize", XS_Digest__SHA_hashsize, file, "$");
+        XSANY.any_i32 = 0;
+        (void)newXSproto_portable("Digest::SHA::stats", XS_Digest__SHA_stats, file, "$");
+        (void)newXSproto_portable("Digest::SHA::global_stats", XS_Digest__SHA_global_stats, file, "");
+        (void)newXSproto_portable("Digest::SHA::add", XS_Digest__SHA_add, file, "$;@");
+        cv = newXSproto_portable("Digest::SHA::b64digest", XS_Digest__SHA_digest, file, "$;@");
+        XSANY.any_i32 = 2;
+        cv = newXSproto_portable("Digest::SHA::digest", XS_Digest__SHA_digest, file, "$;@");
+        XSANY.any_i32 = 0;
+        cv = newXSproto_portable("Digest::SHA::hexdigest", XS_Digest__SHA_digest, file, "$;@");
+        XSANY.any_i32 = 1;
+        cv = newXSproto_portable("Digest::SHA::b64digest_into", XS_Digest__SHA_digest_into, file, "$$;$");
+        XSANY.any_i32 = 2;
+        cv = newXSproto_portable("Digest::SHA::digest_into", XS_Digest__SHA_digest_into, file, "$$;$");
+        XSANY.any_i32 = 0;
+        cv = newXSproto_portable("Digest::SHA::hexdigest_into", XS_Digest__SHA_digest_into, file, "$$;$");
+        XSANY.any_i32 = 1;
+        (void)newXSproto_portable("Digest::SHA::_getstate", XS_Digest__SHA__getstate, file, "$");
+        (void)newXSproto_portable("Digest::SHA::_putstate", XS_Digest__SHA__putstate, file, "$$");
+        (void)newXSproto_portable("Digest::SHA::checkpoint", XS_Digest__SHA_checkpoint, file, "$");
+        (void)newXSproto_portable("Digest::SHA::_resume", XS_Digest__SHA__resume, file, "$$");
+        (void)newXSproto_portable("Digest::SHA::save_states", XS_Digest__SHA_save_states, file, "$;@");
+        (void)newXSproto_portable("Digest::SHA::load_states", XS_Digest__SHA_load_states, file, "$");
+        (void)newXSproto_portable("Digest::SHA::_addfilebin", XS_Digest__SHA__addfilebin, file, "$$");
+        (void)newXSproto_portable("Digest::SHA::_addfilemap", XS_Digest__SHA__addfilemap, file, "$$");
+        (void)newXSproto_portable("Digest::SHA::_addfilepipe", XS_Digest__SHA__addfilepipe, file, "$$$$");
+        (void)newXSproto_portable("Digest::SHA::_async_submit", XS_Digest__SHA__async_submit, file, "$$$$");
+        (void)newXSproto_portable("Digest::SHA::_async_reap", XS_Digest__SHA__async_reap, file, "");
+        (void)newXSproto_portable("Digest::SHA::_async_finish", XS_Digest__SHA__async_finish, file, "$$");
+        (void)newXSproto_portable("Digest::SHA::async_fd", XS_Digest__SHA_async_fd, file, "");
+        (void)newXSproto_portable("Digest::SHA::async_threads", XS_Digest__SHA_async_threads, file, ";$");
+        (void)newXSproto_portable("Digest::SHA::_digestfiles", XS_Digest__SHA__digestfiles, file, "$$$;$");
+        (void)newXSproto_portable("Digest::SHA::_statedigest", XS_Digest__SHA__statedigest, file, "$$;$");
+        (void)newXSproto_portable("Digest::SHA::_pbkdf2", XS_Digest__SHA__pbkdf2, file, "$$$$$");
+        (void)newXSproto_portable("Digest::SHA::_hkdfextract", XS_Digest__SHA__hkdfextract, file, "$$$");
+        (void)newXSproto_portable("Digest::SHA::_hkdfexpand", XS_Digest__SHA__hkdfexpand, file, "$$$$");
+        (void)newXSproto_portable("Digest::SHA::_addfileuniv", XS_Digest__SHA__addfileuniv, file, "$$;$");
+        (void)newXSproto_portable("Digest::SHA::HMAC::_new", XS_Digest__SHA__HMAC__new, file, "$$$");
+        (void)newXSproto_portable("Digest::SHA::HMAC::DESTROY", XS_Digest__SHA__HMAC_DESTROY, file, "$");
+        cv = newXSproto_portable("Digest::SHA::HMAC::algorithm", XS_Digest__SHA__HMAC_algorithm, file, "$");
+        XSANY.any_i32 = 0;
+        cv = newXSproto_portable("Digest::SHA::HMAC::hashsize", XS_Digest__SHA__HMAC_algorithm, file, "$");
+        XSANY.any_i32 = 1;
+        cv = newXSproto_portable("Digest::SHA::HMAC::mac", XS_Digest__SHA__HMAC_mac, file, "$;@");
+        XSANY.any_i32 = 0;
+        cv = newXSproto_portable("Digest::SHA::HMAC::mac_base64", XS_Digest__SHA__HMAC_mac, file, "$;@");
+        XSANY.any_i32 = 2;
+        cv = newXSproto_portable("Digest::SHA::HMAC::mac_hex", XS_Digest__SHA__HMAC_mac, file, "$;@");
+        XSANY.any_i32 = 1;
+        (void)newXSproto_portable("Digest::SHA::Tree::_new", XS_Digest__SHA__Tree__new, file, "$$$$");
+        (void)newXSproto_portable("Digest::SHA::Tree::DESTROY", XS_Digest__SHA__Tree_DESTROY, file, "$");
+        cv = newXSproto_portable("Digest::SHA::Tree::algorithm", XS_Digest__SHA__Tree_algorithm, file, "$");
+        XSANY.any_i32 = 0;
+        cv = newXSproto_portable("Digest::SHA::Tree::hashsize", XS_Digest__SHA__Tree_algorithm, file, "$");
+        XSANY.any_i32 = 1;
+        cv = newXSproto_portable("Digest::SHA::Tree::jobs", XS_Digest__SHA__Tree_algorithm, file, "$");
+        XSANY.any_i32 = 3;
+        cv = newXSproto_portable("Digest::SHA::Tree::leaf_size", XS_Digest__SHA__Tree_algorithm, file, "$");
+        XSANY.any_i32 = 2;
+        (void)newXSproto_portable("Digest::SHA::Tree::add", XS_Digest__SHA__Tree_add, file, "$;@");
+        (void)newXSproto_portable("Digest::SHA::Tree::reset", XS_Digest__SHA__Tree_reset, file, "$");
+        cv = newXSproto_portable("Digest::SHA::Tree::b64digest", XS_Digest__SHA__Tree_digest, file, "$");
+        XSANY.any_i32 = 2;
+        cv = newXSproto_portable("Digest::SHA::Tree::digest", XS_Digest__SHA__Tree_digest, file, "$");
+        XSANY.any_i32 = 0;
+        cv = newXSproto_portable("Digest::SHA::Tree::hexdigest", XS_Digest__SHA__Tree_digest, file, "$");
+        XSANY.any_i32 = 1;
+        (void)newXSproto_portable("Digest::SHA::Tree::_addfilemap", XS_Digest__SHA__Tree__addfilemap, file, "$$");
+        (void)newXSproto_portable("Digest::SHA::CDC::_new", XS_Digest__SHA__CDC__new, file, "$$$$$$");
+        (void)newXSproto_portable("Digest::SHA::CDC::DESTROY", XS_Digest__SHA__CDC_DESTROY, file, "$");
+        cv = newXSproto_portable("Digest::SHA::CDC::algorithm", XS_Digest__SHA__CDC_algorithm, file, "$");
+        XSANY.any_i32 = 0;
+        cv = newXSproto_portable("Digest::SHA::CDC::avg_size", XS_Digest__SHA__CDC_algorithm, file, "$");
+        XSANY.any_i32 = 3;
+        cv = newXSproto_portable("Digest::SHA::CDC::hashsize", XS_Digest__SHA__CDC_algorithm, file, "$");
+        XSANY.any_i32 = 1;
+        cv = newXSproto_portable("Digest::SHA::CDC::max_size", XS_Digest__SHA__CDC_algorithm, file, "$");
+        XSANY.any_i32 = 4;
+        cv = newXSproto_portable("Digest::SHA::CDC::min_size", XS_Digest__SHA__CDC_algorithm, file, "$");
+        XSANY.any_i32 = 2;
+        (void)newXSproto_portable("Digest::SHA::CDC::add", XS_Digest__SHA__CDC_add, file, "$;@");
+        (void)newXSproto_portable("Digest::SHA::CDC::finish", XS_Digest__SHA__CDC_finish, file, "$");
+        (void)newXSproto_portable("Digest::SHA::CDC::reset", XS_Digest__SHA__CDC_reset, file, "$");
+        (void)newXSproto_portable("Digest::SHA::Cache::_open", XS_Digest__SHA__Cache__open, file, "$$$;$");
+        (void)newXSproto_portable("Digest::SHA::Cache::DESTROY", XS_Digest__SHA__Cache_DESTROY, file, "$");
+        (void)newXSproto_portable("Digest::SHA::Cache::_statkey", XS_Digest__SHA__Cache__statkey, file, "$");
+        (void)newXSproto_portable("Digest::SHA::Cache::get", XS_Digest__SHA__Cache_get, file, "$$$$");
+        (void)newXSproto_portable("Digest::SHA::Cache::put", XS_Digest__SHA__Cache_put, file, "$$$$$");
+
+    /* Initialisation Section */
+
+#line 261 "SHA.xs"
+	shadispatch(~0);
+	ckptinit();
+
+#line 2766 "SHA.c"
+
+    /* End of Initialisation Section */
+
+#if PERL_VERSION_LE(5, 21, 5)
+#  if PERL_VERSION_GE(5, 9, 0)
+    if (PL_unitcheckav)
+        call_list(PL_scopestack_ix, PL_unitcheckav);
+#  endif
+    XSRETURN_YES;
+#else
+    Perl_xs_boot_epilog(aTHX_ ax);
+#endif
+}
+
@@ -15,6 +15,9 @@
 #ifndef PerlIO
 	#define PerlIO				FILE
 	#define PerlIO_read(f, buf, count)	fread(buf, 1, count, f)
+	#define PerlIO_fileno(f)		fileno(f)
+	#define PerlIO_tell(f)			ftell(f)
+	#define PerlIO_seek(f, off, whence)	fseek(f, off, whence)
 #endif
 
 #ifndef sv_derived_from
@@ -27,6 +30,13 @@
 #endif
 
 #include "src/sha.c"
+#include "src/shapool.c"
+#include "src/shaio.c"
+#include "src/shatree.c"
+#include "src/shacdc.c"
+#include "src/shacache.c"
+#include "src/shackpt.c"
+#include "src/shaasync.c"
 
 static int ix2alg[] =
 	{1,1,1,224,224,224,256,256,256,384,384,384,512,512,512,
@@ -36,8 +46,8 @@ static int ix2alg[] =
 #define INT2PTR(p, i) (p) (i)
 #endif
 
-#define MAX_WRITE_SIZE 16384
 #define IO_BUFFER_SIZE 4096
+#define MANY_BATCH_SIZE 32
 
 static SHA *getSHA(SV *self)
 {
@@ -46,10 +56,229 @@ static SHA *getSHA(SV *self)
 	return INT2PTR(SHA *, SvIV(SvRV(self)));
 }
 
+#ifdef MULTIPLICITY
+	#define SHA_INTERP	((void *) aTHX)
+#else
+	#define SHA_INTERP	NULL
+#endif
+
+#ifdef call_atexit
+/*
+ * asyncexit: forgets this interpreter's background jobs at its end;
+ * looks them up by interpreter, since clones inherit the exit list
+ */
+static void asyncexit(pTHX_ void *arg)
+{
+	(void) arg;
+	asyncdrop(SHA_INTERP);
+}
+#endif
+
+/* asyncself: returns the owner of this interpreter's background jobs */
+static SHAOWNER *asyncself(pTHX)
+{
+	SHAOWNER *o;
+	int made;
+
+	o = asyncowner(SHA_INTERP, &made);
+#ifdef call_atexit
+	if (o != NULL && made)
+		call_atexit(asyncexit, NULL);
+#endif
+	return(o);
+}
+
+#ifdef SHA_CACHE
+static SHACACHE *getCache(SV *self)
+{
+	if (!sv_isobject(self) || !sv_derived_from(self, "Digest::SHA::Cache"))
+		return(NULL);
+	return INT2PTR(SHACACHE *, SvIV(SvRV(self)));
+}
+#endif
+
+static SHATREE *getTree(SV *self)
+{
+	if (!sv_isobject(self) || !sv_derived_from(self, "Digest::SHA::Tree"))
+		return(NULL);
+	return INT2PTR(SHATREE *, SvIV(SvRV(self)));
+}
+
+static HMAC *getHMAC(SV *self)
+{
+	if (!sv_isobject(self) || !sv_derived_from(self, "Digest::SHA::HMAC"))
+		return(NULL);
+	return INT2PTR(HMAC *, SvIV(SvRV(self)));
+}
+
+/* enclen: returns length of an n-byte digest in the given format */
+static STRLEN enclen(UINT n, int format)
+{
+	return(format == 0 ? n : format == 1 ? HEXLEN(n) : B64LEN(n));
+}
+
+/*
+ * encode: writes digest d (n bytes) to out as binary (0), hex (1), or
+ * base64 (2), followed by a NUL; returns the length written
+ */
+static STRLEN encode(UCHR *d, UINT n, int format, int flags, char *out)
+{
+	if (format == 1)
+		return(hexenc(d, n, out));
+	if (format == 2)
+		return(b64enc(d, n, out, flags));
+	Copy(d, out, n, char);
+	out[n] = '\0';
+	return(n);
+}
+
+/*
+ * encsv: returns a new SV holding digest d (n bytes) as binary (0),
+ * hex (1), or base64 (2), encoded straight into the SV's buffer
+ */
+static SV *encsv(UCHR *d, UINT n, int format, int flags)
+{
+	SV *sv;
+	char *p;
+
+	sv = newSV(enclen(n, format) + 2);
+	p = SvPVX(sv);
+	SvCUR_set(sv, encode(d, n, format, flags, p));
+	SvPOK_only(sv);
+	return(sv);
+}
+
+/*
+ * intobuf: readies the string in sv to receive len bytes at offset,
+ * keeping the bytes before offset (and zero-filling up to it), and
+ * reallocating only if the buffer is too small; returns the place to
+ * write, or NULL if sv can't be written
+ */
+static char *intobuf(SV *sv, IV offset, STRLEN len)
+{
+	STRLEN cur;
+	char *p;
+
+	if (offset < 0 || SvREADONLY(sv))
+		return(NULL);
+	if (!SvOK(sv))
+		sv_setpvn(sv, "", 0);
+	(void) SvPV_force(sv, cur);
+	if (SvUTF8(sv) && !sv_utf8_downgrade(sv, 1))
+		return(NULL);
+	cur = SvCUR(sv);
+	p = SvGROW(sv, (STRLEN) offset + len + 1);
+	if ((STRLEN) offset > cur)
+		Zero(p + cur, (STRLEN) offset - cur, char);
+	SvCUR_set(sv, (STRLEN) offset + len);
+	SvPOK_only(sv);
+	return(p + offset);
+}
+
+/* digestsv: returns finished digest as binary (0), hex (1), or base64 (2) */
+static SV *digestsv(SHA *s, int format)
+{
+	return(encsv(shadigest(s), s->digestlen, format, 0));
+}
+
+#if defined(SHA_STATS)
+
+#if UVSIZE >= 8
+	#define STATSV(n)	newSVuv((UV) (n))
+#else
+	#define STATSV(n)	newSVnv((NV) (n))
+#endif
+
+#define STATSTORE(hv, st, field) \
+	(void) hv_store(hv, #field, sizeof(#field) - 1, STATSV((st)->field), 0)
+
+/* statsref: returns a reference to a hash holding the counters in st */
+static SV *statsref(SHASTATS *st)
+{
+	HV *hv = newHV();
+
+	STATSTORE(hv, st, blocks);
+	STATSTORE(hv, st, direct);
+	STATSTORE(hv, st, bytes);
+	STATSTORE(hv, st, bits);
+	STATSTORE(hv, st, partial);
+	STATSTORE(hv, st, finish);
+	STATSTORE(hv, st, reads);
+	STATSTORE(hv, st, readbytes);
+	return(newRV_noinc((SV *) hv));
+}
+
+#endif
+
+/* slabstate: stores a new object for checkpoint rec (or undef) in AV arg */
+static void slabstate(void *arg, long i, UCHR *rec)
+{
+	dTHX;
+	SHA *state;
+	SV *sv = newSV(0);
+
+	if ((state = shaalloc()) != NULL) {
+		if (ckptload(state, rec, CKPT_LEN)) {
+			sv_setref_pv(sv, "Digest::SHA", (void *) state);
+			SvREADONLY_on(SvRV(sv));
+		}
+		else
+			shafree(state);
+	}
+	av_store((AV *) arg, (I32) i, sv);
+}
+
+static SHACDC *getCDC(SV *self)
+{
+	if (!sv_isobject(self) || !sv_derived_from(self, "Digest::SHA::CDC"))
+		return(NULL);
+	return INT2PTR(SHACDC *, SvIV(SvRV(self)));
+}
+
+/* cdcchunk: finishes the current chunk, returning [offset, length, digest] */
+static SV *cdcchunk(SHACDC *c)
+{
+	AV *chunk = newAV();
+
+#if UVSIZE >= 8
+	av_push(chunk, newSVuv(((UV) c->offhi << 32) + c->offlo));
+#else
+	av_push(chunk, c->offhi ? newSVnv(c->offhi * 4294967296.0 + c->offlo)
+		: newSVuv(c->offlo));
+#endif
+	av_push(chunk, newSVuv(c->len));
+	shafinish(&c->sha);
+	av_push(chunk, digestsv(&c->sha, c->format));
+	cdcnext(c);
+	return(newRV_noinc((SV *) chunk));
+}
+
 MODULE = Digest::SHA		PACKAGE = Digest::SHA
 
 PROTOTYPES: ENABLE
 
+BOOT:
+	shadispatch(~0);
+	ckptinit();
+
+int
+shadispatch(mask)
+	int	mask
+
+int
+_cpuid()
+CODE:
+	RETVAL = shacpuid();
+OUTPUT:
+	RETVAL
+
+NV
+_cycles()
+CODE:
+	RETVAL = shacycles();
+OUTPUT:
+	RETVAL
+
 int
 shainit(s, alg)
 	SHA *	s
@@ -72,9 +301,10 @@ newSHA(classname, alg)
 PREINIT:
 	SHA *state;
 CODE:
-	Newxz(state, 1, SHA);
+	if ((state = shaalloc()) == NULL)
+		XSRETURN_UNDEF;
 	if (!shainit(state, alg)) {
-		Safefree(state);
+		shafree(state);
 		XSRETURN_UNDEF;
 	}
 	RETVAL = newSV(0);
@@ -92,7 +322,8 @@ PREINIT:
 CODE:
 	if ((state = getSHA(self)) == NULL)
 		XSRETURN_UNDEF;
-	Newx(clone, 1, SHA);
+	if ((clone = shaalloc()) == NULL)
+		XSRETURN_UNDEF;
 	RETVAL = newSV(0);
 	sv_setref_pv(RETVAL, sv_reftype(SvRV(self), 1), (void *) clone);
 	SvREADONLY_on(SvRV(RETVAL));
@@ -104,7 +335,7 @@ void
 DESTROY(s)
 	SHA *	s
 CODE:
-	Safefree(s);
+	shafree(s);
 	
 SV *
 sha1(...)
@@ -135,30 +366,121 @@ PREINIT:
 	UCHR *data;
 	STRLEN len;
 	SHA sha;
-	char *result;
 CODE:
 	if (!shainit(&sha, ix2alg[ix]))
 		XSRETURN_UNDEF;
 	for (i = 0; i < items; i++) {
 		data = (UCHR *) (SvPVbyte(ST(i), len));
-		while (len > MAX_WRITE_SIZE) {
-			shawrite(data, MAX_WRITE_SIZE << 3, &sha);
-			data += MAX_WRITE_SIZE;
-			len  -= MAX_WRITE_SIZE;
-		}
-		shawrite(data, len << 3, &sha);
+		shawritebytes(data, len, &sha);
 	}
 	shafinish(&sha);
-	len = 0;
-	if (ix % 3 == 0) {
-		result = (char *) shadigest(&sha);
-		len = sha.digestlen;
+	RETVAL = digestsv(&sha, ix % 3);
+OUTPUT:
+	RETVAL
+
+void
+sha1_many(aref)
+	SV *	aref
+ALIAS:
+	Digest::SHA::sha1_many = 0
+	Digest::SHA::sha1_hex_many = 1
+	Digest::SHA::sha1_base64_many = 2
+	Digest::SHA::sha224_many = 3
+	Digest::SHA::sha224_hex_many = 4
+	Digest::SHA::sha224_base64_many = 5
+	Digest::SHA::sha256_many = 6
+	Digest::SHA::sha256_hex_many = 7
+	Digest::SHA::sha256_base64_many = 8
+	Digest::SHA::sha384_many = 9
+	Digest::SHA::sha384_hex_many = 10
+	Digest::SHA::sha384_base64_many = 11
+	Digest::SHA::sha512_many = 12
+	Digest::SHA::sha512_hex_many = 13
+	Digest::SHA::sha512_base64_many = 14
+	Digest::SHA::sha512224_many = 15
+	Digest::SHA::sha512224_hex_many = 16
+	Digest::SHA::sha512224_base64_many = 17
+	Digest::SHA::sha512256_many = 18
+	Digest::SHA::sha512256_hex_many = 19
+	Digest::SHA::sha512256_base64_many = 20
+PREINIT:
+	int j, k;
+	SSize_t n, base;
+	AV *av;
+	SV **svp;
+	STRLEN len;
+	SHA sha[MANY_BATCH_SIZE];
+	UCHR *data[MANY_BATCH_SIZE];
+	size_t size[MANY_BATCH_SIZE];
+PPCODE:
+	if (!SvROK(aref) || SvTYPE(SvRV(aref)) != SVt_PVAV)
+		XSRETURN_EMPTY;
+	if (!shainit(&sha[0], ix2alg[ix]))
+		XSRETURN_EMPTY;
+	av = (AV *) SvRV(aref);
+	n = av_len(av) + 1;
+	EXTEND(SP, n);
+	for (base = 0; base < n; base += k) {
+		k = n - base < MANY_BATCH_SIZE ? (int) (n - base) :
+			MANY_BATCH_SIZE;
+		for (j = 0; j < k; j++) {
+			len = 0;
+			svp = av_fetch(av, base + j, 0);
+			data[j] = svp ? (UCHR *) (SvPVbyte(*svp, len)) :
+				(UCHR *) "";
+			size[j] = len;
+			shainit(&sha[j], ix2alg[ix]);
+		}
+		shamulti(sha, data, size, k);
+		for (j = 0; j < k; j++)
+			PUSHs(sv_2mortal(digestsv(&sha[j], ix % 3)));
 	}
-	else if (ix % 3 == 1)
-		result = shahex(&sha);
-	else
-		result = shabase64(&sha);
-	RETVAL = newSVpv(result, len);
+
+SV *
+sha1_into(buf, ...)
+	SV *	buf
+ALIAS:
+	Digest::SHA::sha1_into = 0
+	Digest::SHA::sha1_hex_into = 1
+	Digest::SHA::sha1_base64_into = 2
+	Digest::SHA::sha224_into = 3
+	Digest::SHA::sha224_hex_into = 4
+	Digest::SHA::sha224_base64_into = 5
+	Digest::SHA::sha256_into = 6
+	Digest::SHA::sha256_hex_into = 7
+	Digest::SHA::sha256_base64_into = 8
+	Digest::SHA::sha384_into = 9
+	Digest::SHA::sha384_hex_into = 10
+	Digest::SHA::sha384_base64_into = 11
+	Digest::SHA::sha512_into = 12
+	Digest::SHA::sha512_hex_into = 13
+	Digest::SHA::sha512_base64_into = 14
+	Digest::SHA::sha512224_into = 15
+	Digest::SHA::sha512224_hex_into = 16
+	Digest::SHA::sha512224_base64_into = 17
+	Digest::SHA::sha512256_into = 18
+	Digest::SHA::sha512256_hex_into = 19
+	Digest::SHA::sha512256_base64_into = 20
+PREINIT:
+	int i;
+	UCHR *data;
+	STRLEN len;
+	SHA sha;
+	char *p;
+CODE:
+	if (!shainit(&sha, ix2alg[ix]))
+		XSRETURN_UNDEF;
+	for (i = 1; i < items; i++) {
+		data = (UCHR *) (SvPVbyte(ST(i), len));
+		shawritebytes(data, len, &sha);
+	}
+	shafinish(&sha);
+	len = enclen(sha.digestlen, ix % 3);
+	if ((p = intobuf(buf, 0, len)) == NULL)
+		XSRETURN_UNDEF;
+	encode(shadigest(&sha), sha.digestlen, ix % 3, 0, p);
+	SvSETMAGIC(buf);
+	RETVAL = newSVuv(len);
 OUTPUT:
 	RETVAL
 
@@ -192,7 +514,6 @@ PREINIT:
 	UCHR *data;
 	STRLEN len = 0;
 	HMAC hmac;
-	char *result;
 CODE:
 	if (items > 0) {
 		key = (UCHR *) (SvPVbyte(ST(items-1), len));
@@ -201,24 +522,10 @@ CODE:
 		XSRETURN_UNDEF;
 	for (i = 0; i < items - 1; i++) {
 		data = (UCHR *) (SvPVbyte(ST(i), len));
-		while (len > MAX_WRITE_SIZE) {
-			hmacwrite(data, MAX_WRITE_SIZE << 3, &hmac);
-			data += MAX_WRITE_SIZE;
-			len  -= MAX_WRITE_SIZE;
-		}
-		hmacwrite(data, len << 3, &hmac);
+		hmacwritebytes(data, len, &hmac);
 	}
 	hmacfinish(&hmac);
-	len = 0;
-	if (ix % 3 == 0) {
-		result = (char *) hmacdigest(&hmac);
-		len = hmac.digestlen;
-	}
-	else if (ix % 3 == 1)
-		result = hmachex(&hmac);
-	else
-		result = hmacbase64(&hmac);
-	RETVAL = newSVpv(result, len);
+	RETVAL = digestsv(&hmac.osha, ix % 3);
 OUTPUT:
 	RETVAL
 
@@ -237,6 +544,33 @@ CODE:
 OUTPUT:
 	RETVAL
 
+SV *
+stats(self)
+	SV *	self
+PREINIT:
+	SHA *state;
+CODE:
+	if ((state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+#if defined(SHA_STATS)
+	RETVAL = statsref(&state->stats);
+#else
+	XSRETURN_UNDEF;
+#endif
+OUTPUT:
+	RETVAL
+
+SV *
+global_stats()
+CODE:
+#if defined(SHA_STATS)
+	RETVAL = statsref(&shastats);
+#else
+	XSRETURN_UNDEF;
+#endif
+OUTPUT:
+	RETVAL
+
 void
 add(self, ...)
 	SV *	self
@@ -250,41 +584,66 @@ PPCODE:
 		XSRETURN_UNDEF;
 	for (i = 1; i < items; i++) {
 		data = (UCHR *) (SvPVbyte(ST(i), len));
-		while (len > MAX_WRITE_SIZE) {
-			shawrite(data, MAX_WRITE_SIZE << 3, state);
-			data += MAX_WRITE_SIZE;
-			len  -= MAX_WRITE_SIZE;
-		}
-		shawrite(data, len << 3, state);
+		shawritebytes(data, len, state);
 	}
 	XSRETURN(1);
 
 SV *
-digest(self)
+digest(self, ...)
 	SV *	self
 ALIAS:
 	Digest::SHA::digest = 0
 	Digest::SHA::hexdigest = 1
 	Digest::SHA::b64digest = 2
 PREINIT:
-	STRLEN len;
+	int i;
+	int flags = 0;
+	char *opt;
 	SHA *state;
-	char *result;
 CODE:
 	if ((state = getSHA(self)) == NULL)
 		XSRETURN_UNDEF;
-	shafinish(state);
-	len = 0;
-	if (ix == 0) {
-		result = (char *) shadigest(state);
-		len = state->digestlen;
+	if (items > 1 && (ix != 2 || items % 2 == 0))
+		XSRETURN_UNDEF;		/* options are for b64digest */
+	for (i = 1; i + 1 < items; i += 2) {
+		opt = SvPV_nolen(ST(i));
+		if (strEQ(opt, "url"))
+			flags |= SvTRUE(ST(i+1)) ? SHA_B64_URL : 0;
+		else if (strEQ(opt, "pad"))
+			flags |= SvTRUE(ST(i+1)) ? SHA_B64_PAD : 0;
+		else
+			XSRETURN_UNDEF;
 	}
-	else if (ix == 1)
-		result = shahex(state);
-	else
-		result = shabase64(state);
-	RETVAL = newSVpv(result, len);
+	shafinish(state);
+	RETVAL = encsv(shadigest(state), state->digestlen, ix, flags);
+	sharewind(state);
+OUTPUT:
+	RETVAL
+
+SV *
+digest_into(self, buf, offset = 0)
+	SV *	self
+	SV *	buf
+	IV	offset
+ALIAS:
+	Digest::SHA::digest_into = 0
+	Digest::SHA::hexdigest_into = 1
+	Digest::SHA::b64digest_into = 2
+PREINIT:
+	SHA *state;
+	STRLEN len;
+	char *p;
+CODE:
+	if ((state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	len = enclen(state->digestlen, ix);
+	if ((p = intobuf(buf, offset, len)) == NULL)
+		XSRETURN_UNDEF;
+	shafinish(state);
+	encode(shadigest(state), state->digestlen, ix, 0, p);
+	SvSETMAGIC(buf);
 	sharewind(state);
+	RETVAL = newSVuv(len);
 OUTPUT:
 	RETVAL
 
@@ -293,21 +652,13 @@ _getstate(self)
 	SV *	self
 PREINIT:
 	SHA *state;
-	UCHR buf[256];
-	UCHR *ptr = buf;
+	UCHR buf[SHA_MAX_STATE_LEN];
+	UINT len;
 CODE:
 	if ((state = getSHA(self)) == NULL)
 		XSRETURN_UNDEF;
-	Copy(digcpy(state), ptr, state->alg <= SHA256 ? 32 : 64, UCHR);
-	ptr += state->alg <= SHA256 ? 32 : 64;
-	Copy(state->block, ptr, state->alg <= SHA256 ? 64 : 128, UCHR);
-	ptr += state->alg <= SHA256 ? 64 : 128;
-	ptr = w32mem(ptr, state->blockcnt);
-	ptr = w32mem(ptr, state->lenhh);
-	ptr = w32mem(ptr, state->lenhl);
-	ptr = w32mem(ptr, state->lenlh);
-	ptr = w32mem(ptr, state->lenll);
-	RETVAL = newSVpv((char *) buf, (STRLEN) (ptr - buf));
+	len = shapack(state, buf);
+	RETVAL = newSVpv((char *) buf, (STRLEN) len);
 OUTPUT:
 	RETVAL
 
@@ -316,7 +667,6 @@ _putstate(self, packed_state)
 	SV *	self
 	SV *	packed_state
 PREINIT:
-	UINT bc;
 	STRLEN len;
 	SHA *state;
 	UCHR *data;
@@ -324,21 +674,75 @@ PPCODE:
 	if ((state = getSHA(self)) == NULL)
 		XSRETURN_UNDEF;
 	data = (UCHR *) SvPV(packed_state, len);
-	if (len != (state->alg <= SHA256 ? 116U : 212U))
-		XSRETURN_UNDEF;
-	data = statecpy(state, data);
-	Copy(data, state->block, state->blocksize >> 3, UCHR);
-	data += (state->blocksize >> 3);
-	bc = memw32(data), data += 4;
-	if (bc >= (state->alg <= SHA256 ? 512U : 1024U))
-		XSRETURN_UNDEF;
-	state->blockcnt = bc;
-	state->lenhh = memw32(data), data += 4;
-	state->lenhl = memw32(data), data += 4;
-	state->lenlh = memw32(data), data += 4;
-	state->lenll = memw32(data);
+	if (len > SHA_MAX_STATE_LEN || !shaunpack(state, data, (UINT) len))
+		XSRETURN_UNDEF;
+	XSRETURN(1);
+
+SV *
+checkpoint(self)
+	SV *	self
+PREINIT:
+	SHA *state;
+	UCHR rec[CKPT_LEN];
+CODE:
+	if ((state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	ckptsave(state, rec);
+	RETVAL = newSVpvn((char *) rec, CKPT_LEN);
+OUTPUT:
+	RETVAL
+
+void
+_resume(self, ckpt)
+	SV *	self
+	SV *	ckpt
+PREINIT:
+	STRLEN len;
+	SHA *state;
+	UCHR *data;
+PPCODE:
+	if ((state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	data = (UCHR *) SvPVbyte(ckpt, len);
+	if (!ckptload(state, data, len))
+		XSRETURN_UNDEF;
 	XSRETURN(1);
 
+SV *
+save_states(file, ...)
+	char *	file
+PREINIT:
+	int i, ok;
+	SHA **states;
+CODE:
+	Newx(states, items, SHA *);
+	for (i = 1; i < items; i++)
+		if ((states[i-1] = getSHA(ST(i))) == NULL) {
+			Safefree(states);
+			XSRETURN_UNDEF;
+		}
+	ok = slabsave(file, states, items - 1);
+	Safefree(states);
+	if (!ok)
+		XSRETURN_UNDEF;
+	RETVAL = newSViv(items - 1);
+OUTPUT:
+	RETVAL
+
+void
+load_states(file)
+	char *	file
+PREINIT:
+	AV *av;
+	long i, n;
+PPCODE:
+	av = (AV *) sv_2mortal((SV *) newAV());
+	if ((n = slabload(file, slabstate, (void *) av)) < 0)
+		XSRETURN_EMPTY;
+	EXTEND(SP, n);
+	for (i = 0; i < n; i++)
+		PUSHs(sv_2mortal(SvREFCNT_inc(*av_fetch(av, (I32) i, 0))));
+
 void
 _addfilebin(self, f)
 	SV *		self
@@ -350,51 +754,771 @@ PREINIT:
 PPCODE:
 	if (!f || (state = getSHA(self)) == NULL)
 		XSRETURN_UNDEF;
-	while ((n = PerlIO_read(f, in, sizeof(in))) > 0)
+	while ((n = PerlIO_read(f, in, sizeof(in))) > 0) {
+		SHA_STAT(state, reads, 1);
+		SHA_STAT(state, readbytes, n);
 		shawrite(in, (ULNG) n << 3, state);
+	}
 	XSRETURN(1);
 
 void
-_addfileuniv(self, f)
+_addfilemap(self, f)
 	SV *		self
 	PerlIO *	f
 PREINIT:
-	UCHR c;
+	SHA *state;
+	Off_t pos;
 	int n;
-	int cr = 0;
-	UCHR *src, *dst;
-	UCHR in[IO_BUFFER_SIZE+1];
+PPCODE:
+	if (!f || (state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	if ((pos = PerlIO_tell(f)) < 0)
+		XSRETURN_UNDEF;
+	if ((n = shamapfd(state, PerlIO_fileno(f), pos)) == 0)
+		XSRETURN_UNDEF;
+	PerlIO_seek(f, 0, SEEK_END);
+	if (n < 0)
+		XSRETURN_NO;
+	XSRETURN(1);
+
+void
+_addfilepipe(self, f, nbufs, bufsize)
+	SV *		self
+	PerlIO *	f
+	int		nbufs
+	long		bufsize
+PREINIT:
 	SHA *state;
+	Off_t pos;
+	int n;
 PPCODE:
 	if (!f || (state = getSHA(self)) == NULL)
 		XSRETURN_UNDEF;
-	while ((n = PerlIO_read(f, in+1, IO_BUFFER_SIZE)) > 0) {
-		for (dst = in, src = in + 1; n; n--) {
-			c = *src++;
-			if (!cr) {
-				if (c == '\015')
-					cr = 1;
-				else
-					*dst++ = c;
-			}
-			else {
-				if (c == '\015')
-					*dst++ = '\012';
-				else if (c == '\012') {
-					*dst++ = '\012';
-					cr = 0;
-				}
-				else {
-					*dst++ = '\012';
-					*dst++ = c;
-					cr = 0;
-				}
-			}
-		}
-		shawrite(in, (ULNG) (dst - in) << 3, state);
+	if ((pos = PerlIO_tell(f)) < 0)
+		XSRETURN_UNDEF;
+	if ((n = shapipefd(state, PerlIO_fileno(f), pos, nbufs, bufsize)) == 0)
+		XSRETURN_UNDEF;
+	PerlIO_seek(f, 0, SEEK_END);
+	if (n < 0)
+		XSRETURN_NO;
+	XSRETURN(1);
+
+SV *
+_async_submit(self, path, fd, pos)
+	SV *	self
+	SV *	path
+	int	fd
+	IV	pos
+PREINIT:
+	SHA *state;
+	SHAOWNER *o;
+	SHAJOB *j;
+	char *p = NULL;
+	STRLEN len = 0;
+CODE:
+	if ((state = getSHA(self)) == NULL || (o = asyncself(aTHX)) == NULL)
+		XSRETURN_UNDEF;
+	if (SvOK(path))
+		p = SvPV(path, len);
+	if ((j = asyncjob(o, state, p, (size_t) len)) == NULL)
+		XSRETURN_UNDEF;
+	j->pos = (Off_t) pos;
+	if (p == NULL && (j->fd = dup(fd)) < 0) {
+		asyncfree(j);
+		XSRETURN_UNDEF;
 	}
-	if (cr) {
-		in[0] = '\012';
-		shawrite(in, 1 << 3, state);
+	if (!asyncsubmit(j)) {
+		asyncfree(j);
+		XSRETURN_UNDEF;
 	}
-	XSRETURN(1);
+	RETVAL = newSVuv((UV) j->id);
+OUTPUT:
+	RETVAL
+
+void
+_async_reap()
+PREINIT:
+	SHAOWNER *o;
+	SHAJOB *j;
+PPCODE:
+	if ((o = asyncself(aTHX)) == NULL)
+		XSRETURN_EMPTY;
+	for (j = asyncreap(o); j != NULL; j = j->next)
+		XPUSHs(sv_2mortal(newSVuv((UV) j->id)));
+
+SV *
+_async_finish(self, id)
+	SV *	self
+	UV	id
+PREINIT:
+	SHA *state;
+	SHAOWNER *o;
+	SHAJOB *j;
+CODE:
+	if ((o = asyncself(aTHX)) == NULL ||
+		(j = asynctake(o, (ULNG) id)) == NULL)
+		XSRETURN_UNDEF;
+	if (j->err == 0 && (state = getSHA(self)) != NULL)
+		Copy(&j->sha, state, 1, SHA);
+	RETVAL = newSViv(j->err);
+	asyncfree(j);
+OUTPUT:
+	RETVAL
+
+SV *
+async_fd()
+PREINIT:
+	SHAOWNER *o;
+	int fd;
+CODE:
+	if ((o = asyncself(aTHX)) == NULL || (fd = asyncfd(o)) < 0)
+		XSRETURN_UNDEF;
+	RETVAL = newSViv(fd);
+OUTPUT:
+	RETVAL
+
+int
+async_threads(n = 0)
+	int	n
+CODE:
+	RETVAL = asyncmax(n);
+OUTPUT:
+	RETVAL
+
+void
+_digestfiles(alg, paths, jobs, format = 0)
+	int	alg
+	SV *	paths
+	int	jobs
+	int	format
+PREINIT:
+	int i, n;
+	AV *av, *digests, *errs;
+	SV **svp;
+	SHA sha;
+	char **names;
+	UCHR *buf, *state;
+	int *err;
+PPCODE:
+	if (!SvROK(paths) || SvTYPE(SvRV(paths)) != SVt_PVAV)
+		XSRETURN_EMPTY;
+	if (!shainit(&sha, alg))
+		XSRETURN_EMPTY;
+	av = (AV *) SvRV(paths);
+	n = (int) (av_len(av) + 1);
+	Newx(names, n + 1, char *);
+	SAVEFREEPV(names);
+	Newx(buf, (n + 1) * SHA_MAX_STATE_LEN, UCHR);
+	SAVEFREEPV(buf);
+	Newx(err, n + 1, int);
+	SAVEFREEPV(err);
+	for (i = 0; i < n; i++) {
+		svp = av_fetch(av, i, 0);
+		names[i] = svp ? SvPV_nolen(*svp) : (char *) "";
+	}
+	shafiles(alg, names, n, jobs, buf, err);
+	digests = newAV();
+	errs = newAV();
+	for (i = 0; i < n; i++) {
+		av_push(errs, newSViv(err[i]));
+		state = buf + i * SHA_MAX_STATE_LEN;
+		if (err[i])
+			av_push(digests, newSV(0));
+		else if (format == 3)
+			av_push(digests, newSVpv((char *) state,
+				alg <= SHA256 ? 116 : 212));
+		else {
+			shaunpack(&sha, state, alg <= SHA256 ? 116 : 212);
+			shafinish(&sha);
+			av_push(digests, digestsv(&sha, format));
+		}
+	}
+	EXTEND(SP, 2);
+	PUSHs(sv_2mortal(newRV_noinc((SV *) digests)));
+	PUSHs(sv_2mortal(newRV_noinc((SV *) errs)));
+
+SV *
+_statedigest(alg, packed_state, format = 1)
+	int	alg
+	SV *	packed_state
+	int	format
+PREINIT:
+	SHA sha;
+	STRLEN len;
+	UCHR *data;
+CODE:
+	if (!shainit(&sha, alg))
+		XSRETURN_UNDEF;
+	data = (UCHR *) SvPVbyte(packed_state, len);
+	if (len > SHA_MAX_STATE_LEN || !shaunpack(&sha, data, (UINT) len))
+		XSRETURN_UNDEF;
+	shafinish(&sha);
+	RETVAL = digestsv(&sha, format);
+OUTPUT:
+	RETVAL
+
+SV *
+_pbkdf2(alg, password, salt, iterations, dklen)
+	int	alg
+	SV *	password
+	SV *	salt
+	UV	iterations
+	UV	dklen
+PREINIT:
+	UCHR *pw, *sp;
+	STRLEN pwlen, saltlen;
+CODE:
+	pw = (UCHR *) SvPVbyte(password, pwlen);
+	sp = (UCHR *) SvPVbyte(salt, saltlen);
+	if (iterations < 1 || iterations > SHA32_MAX || (STRLEN) dklen != dklen)
+		XSRETURN_UNDEF;
+	RETVAL = newSV(dklen + 1);
+	SvPOK_only(RETVAL);
+	if (!pbkdf2(alg, pw, (UINT) pwlen, sp, saltlen, (ULNG) iterations,
+		(UCHR *) SvPVX(RETVAL), (size_t) dklen)) {
+		SvREFCNT_dec(RETVAL);
+		XSRETURN_UNDEF;
+	}
+	SvCUR_set(RETVAL, dklen);
+	*SvEND(RETVAL) = '\0';
+OUTPUT:
+	RETVAL
+
+SV *
+_hkdfextract(alg, salt, ikm)
+	int	alg
+	SV *	salt
+	SV *	ikm
+PREINIT:
+	UCHR *sp, *kp;
+	STRLEN saltlen, ikmlen;
+	UINT len;
+	UCHR prk[SHA_MAX_DIGEST_BITS/8];
+CODE:
+	sp = (UCHR *) SvPVbyte(salt, saltlen);
+	kp = (UCHR *) SvPVbyte(ikm, ikmlen);
+	if ((len = hkdfextract(alg, sp, (UINT) saltlen, kp, ikmlen, prk)) == 0)
+		XSRETURN_UNDEF;
+	RETVAL = newSVpv((char *) prk, len);
+	Zero(prk, sizeof(prk), UCHR);
+OUTPUT:
+	RETVAL
+
+SV *
+_hkdfexpand(alg, prk, info, len)
+	int	alg
+	SV *	prk
+	SV *	info
+	UV	len
+PREINIT:
+	UCHR *kp, *ip;
+	STRLEN prklen, infolen;
+CODE:
+	kp = (UCHR *) SvPVbyte(prk, prklen);
+	ip = (UCHR *) SvPVbyte(info, infolen);
+	if (len > 255 * (SHA_MAX_DIGEST_BITS/8))
+		XSRETURN_UNDEF;
+	RETVAL = newSV(len + 1);
+	SvPOK_only(RETVAL);
+	if (!hkdfexpand(alg, kp, (UINT) prklen, ip, infolen,
+		(UCHR *) SvPVX(RETVAL), (size_t) len)) {
+		SvREFCNT_dec(RETVAL);
+		XSRETURN_UNDEF;
+	}
+	SvCUR_set(RETVAL, len);
+	*SvEND(RETVAL) = '\0';
+OUTPUT:
+	RETVAL
+
+void
+_addfileuniv(self, f, portable = 0)
+	SV *		self
+	PerlIO *	f
+	int		portable
+PREINIT:
+	int n;
+	UINT held = 0;
+	size_t len;
+	UCHR *p;
+	UCHR *in;
+	SHA *state;
+PPCODE:
+	if (!f || (state = getSHA(self)) == NULL)
+		XSRETURN_UNDEF;
+	Newx(in, 2+SHA_READ_SIZE, UCHR);	/* too big for thread stacks */
+	while ((n = PerlIO_read(f, in+2, SHA_READ_SIZE)) > 0) {
+		SHA_STAT(state, reads, 1);
+		SHA_STAT(state, readbytes, n);
+		in[0] = in[1] = '\015';	/* CRs held from last read */
+		p = in + 2 - held;
+		len = univnl(p, held + (size_t) n, portable, 1, &held);
+		shawritebytes(p, len, state);
+	}
+	if (held) {
+		in[0] = in[1] = '\015';
+		p = in + 2 - held;
+		len = univnl(p, held, portable, 0, &held);
+		shawritebytes(p, len, state);
+	}
+	Safefree(in);
+	XSRETURN(1);
+
+MODULE = Digest::SHA		PACKAGE = Digest::SHA::HMAC
+
+PROTOTYPES: ENABLE
+
+SV *
+_new(classname, alg, key)
+	char *	classname
+	int	alg
+	SV *	key
+PREINIT:
+	HMAC *hmac;
+	UCHR *data;
+	STRLEN len;
+CODE:
+	data = (UCHR *) SvPVbyte(key, len);
+	Newxz(hmac, 1, HMAC);
+	if (hmacinit(hmac, alg, data, (UINT) len) == NULL) {
+		Safefree(hmac);
+		XSRETURN_UNDEF;
+	}
+	RETVAL = newSV(0);
+	sv_setref_pv(RETVAL, classname, (void *) hmac);
+	SvREADONLY_on(SvRV(RETVAL));
+OUTPUT:
+	RETVAL
+
+void
+DESTROY(self)
+	SV *	self
+PREINIT:
+	HMAC *hmac;
+CODE:
+	if ((hmac = getHMAC(self)) != NULL) {
+		Zero(hmac, 1, HMAC);
+		Safefree(hmac);
+	}
+
+int
+algorithm(self)
+	SV *	self
+ALIAS:
+	Digest::SHA::HMAC::algorithm = 0
+	Digest::SHA::HMAC::hashsize = 1
+PREINIT:
+	HMAC *hmac;
+CODE:
+	if ((hmac = getHMAC(self)) == NULL)
+		XSRETURN_UNDEF;
+	RETVAL = ix ? (int) hmac->digestlen << 3 : hmac->osha.alg;
+OUTPUT:
+	RETVAL
+
+SV *
+mac(self, ...)
+	SV *	self
+ALIAS:
+	Digest::SHA::HMAC::mac = 0
+	Digest::SHA::HMAC::mac_hex = 1
+	Digest::SHA::HMAC::mac_base64 = 2
+PREINIT:
+	int i;
+	UCHR *data;
+	STRLEN len;
+	HMAC *key;
+	HMAC hmac;
+CODE:
+	if ((key = getHMAC(self)) == NULL)
+		XSRETURN_UNDEF;
+	Copy(&key->isha, &hmac.isha, 1, SHA);
+	Copy(&key->osha, &hmac.osha, 1, SHA);
+	hmac.digestlen = key->digestlen;
+	for (i = 1; i < items; i++) {
+		data = (UCHR *) (SvPVbyte(ST(i), len));
+		hmacwritebytes(data, len, &hmac);
+	}
+	hmacfinish(&hmac);
+	RETVAL = digestsv(&hmac.osha, ix);
+	Zero(&hmac, 1, HMAC);
+OUTPUT:
+	RETVAL
+
+MODULE = Digest::SHA		PACKAGE = Digest::SHA::Tree
+
+PROTOTYPES: ENABLE
+
+SV *
+_new(classname, alg, leafsize, jobs)
+	char *	classname
+	int	alg
+	UV	leafsize
+	int	jobs
+PREINIT:
+	SHATREE *tree;
+CODE:
+	Newx(tree, 1, SHATREE);
+	if (leafsize > SHA_TREE_MAX_LEAF ||
+		treeinit(tree, alg, (ULNG) leafsize, jobs) == NULL) {
+		Safefree(tree);
+		XSRETURN_UNDEF;
+	}
+	RETVAL = newSV(0);
+	sv_setref_pv(RETVAL, classname, (void *) tree);
+	SvREADONLY_on(SvRV(RETVAL));
+OUTPUT:
+	RETVAL
+
+void
+DESTROY(self)
+	SV *	self
+PREINIT:
+	SHATREE *tree;
+CODE:
+	if ((tree = getTree(self)) != NULL)
+		Safefree(tree);
+
+UV
+algorithm(self)
+	SV *	self
+ALIAS:
+	Digest::SHA::Tree::algorithm = 0
+	Digest::SHA::Tree::hashsize = 1
+	Digest::SHA::Tree::leaf_size = 2
+	Digest::SHA::Tree::jobs = 3
+PREINIT:
+	SHATREE *tree;
+CODE:
+	if ((tree = getTree(self)) == NULL)
+		XSRETURN_UNDEF;
+	if (ix == 0)
+		RETVAL = tree->alg;
+	else if (ix == 1)
+		RETVAL = tree->result.digestlen << 3;
+	else if (ix == 2)
+		RETVAL = tree->leafsize;
+	else
+		RETVAL = tree->nthreads;
+OUTPUT:
+	RETVAL
+
+void
+add(self, ...)
+	SV *	self
+PREINIT:
+	int i;
+	UCHR *data;
+	STRLEN len;
+	SHATREE *tree;
+PPCODE:
+	if ((tree = getTree(self)) == NULL)
+		XSRETURN_UNDEF;
+	for (i = 1; i < items; i++) {
+		data = (UCHR *) (SvPVbyte(ST(i), len));
+		treewrite(tree, data, len);
+	}
+	XSRETURN(1);
+
+void
+reset(self)
+	SV *	self
+PREINIT:
+	SHATREE *tree;
+PPCODE:
+	if ((tree = getTree(self)) == NULL)
+		XSRETURN_UNDEF;
+	treereset(tree);
+	XSRETURN(1);
+
+SV *
+digest(self)
+	SV *	self
+ALIAS:
+	Digest::SHA::Tree::digest = 0
+	Digest::SHA::Tree::hexdigest = 1
+	Digest::SHA::Tree::b64digest = 2
+PREINIT:
+	SHATREE *tree;
+CODE:
+	if ((tree = getTree(self)) == NULL)
+		XSRETURN_UNDEF;
+	treefinish(tree);
+	RETVAL = digestsv(&tree->result, ix);
+OUTPUT:
+	RETVAL
+
+void
+_addfilemap(self, f)
+	SV *		self
+	PerlIO *	f
+PREINIT:
+	SHATREE *tree;
+	Off_t pos;
+	int n;
+PPCODE:
+	if (!f || (tree = getTree(self)) == NULL)
+		XSRETURN_UNDEF;
+	if ((pos = PerlIO_tell(f)) < 0)
+		XSRETURN_UNDEF;
+	if ((n = treemapfd(tree, PerlIO_fileno(f), pos)) == 0)
+		XSRETURN_UNDEF;
+	PerlIO_seek(f, 0, SEEK_END);
+	if (n < 0)
+		XSRETURN_NO;
+	XSRETURN(1);
+
+MODULE = Digest::SHA		PACKAGE = Digest::SHA::CDC
+
+PROTOTYPES: ENABLE
+
+SV *
+_new(classname, alg, minsize, avgsize, maxsize, format)
+	char *	classname
+	int	alg
+	UV	minsize
+	UV	avgsize
+	UV	maxsize
+	int	format
+PREINIT:
+	SHACDC *cdc;
+CODE:
+	Newx(cdc, 1, SHACDC);
+	if (maxsize > SHA_CDC_MAX_LIMIT || cdcinit(cdc, alg, (UINT) minsize,
+		(UINT) avgsize, (UINT) maxsize) == NULL) {
+		Safefree(cdc);
+		XSRETURN_UNDEF;
+	}
+	cdc->format = format;
+	RETVAL = newSV(0);
+	sv_setref_pv(RETVAL, classname, (void *) cdc);
+	SvREADONLY_on(SvRV(RETVAL));
+OUTPUT:
+	RETVAL
+
+void
+DESTROY(self)
+	SV *	self
+PREINIT:
+	SHACDC *cdc;
+CODE:
+	if ((cdc = getCDC(self)) != NULL)
+		Safefree(cdc);
+
+UV
+algorithm(self)
+	SV *	self
+ALIAS:
+	Digest::SHA::CDC::algorithm = 0
+	Digest::SHA::CDC::hashsize = 1
+	Digest::SHA::CDC::min_size = 2
+	Digest::SHA::CDC::avg_size = 3
+	Digest::SHA::CDC::max_size = 4
+PREINIT:
+	SHACDC *cdc;
+CODE:
+	if ((cdc = getCDC(self)) == NULL)
+		XSRETURN_UNDEF;
+	if (ix == 0)
+		RETVAL = cdc->alg;
+	else if (ix == 1)
+		RETVAL = cdc->sha.digestlen << 3;
+	else
+		RETVAL = ix == 2 ? cdc->minsize :
+			(ix == 3 ? cdc->avgsize : cdc->maxsize);
+OUTPUT:
+	RETVAL
+
+void
+add(self, ...)
+	SV *	self
+PREINIT:
+	int i, done;
+	UCHR *data;
+	STRLEN len;
+	size_t n;
+	SSize_t j, nchunks;
+	SHACDC *cdc;
+	AV *chunks;
+PPCODE:
+	if ((cdc = getCDC(self)) == NULL)
+		XSRETURN_EMPTY;
+	chunks = (AV *) sv_2mortal((SV *) newAV());
+	for (i = 1; i < items; i++) {
+		data = (UCHR *) (SvPVbyte(ST(i), len));
+		while (len > 0) {
+			n = cdcwrite(cdc, data, len, &done);
+			data += n;
+			len -= n;
+			if (done)
+				av_push(chunks, cdcchunk(cdc));
+		}
+	}
+	nchunks = av_len(chunks) + 1;
+	EXTEND(SP, nchunks);
+	for (j = 0; j < nchunks; j++)
+		PUSHs(sv_2mortal(SvREFCNT_inc(*av_fetch(chunks, j, 0))));
+
+void
+finish(self)
+	SV *	self
+PREINIT:
+	SHACDC *cdc;
+PPCODE:
+	if ((cdc = getCDC(self)) == NULL)
+		XSRETURN_EMPTY;
+	if (cdc->len > 0)
+		XPUSHs(sv_2mortal(cdcchunk(cdc)));
+	cdcreset(cdc);
+
+void
+reset(self)
+	SV *	self
+PREINIT:
+	SHACDC *cdc;
+PPCODE:
+	if ((cdc = getCDC(self)) == NULL)
+		XSRETURN_UNDEF;
+	cdcreset(cdc);
+	XSRETURN(1);
+
+MODULE = Digest::SHA		PACKAGE = Digest::SHA::Cache
+
+PROTOTYPES: ENABLE
+
+SV *
+_open(classname, file, rebuild, racy = -1)
+	char *	classname
+	char *	file
+	int	rebuild
+	int	racy
+PREINIT:
+#ifdef SHA_CACHE
+	SHACACHE *cache;
+#endif
+CODE:
+#ifdef SHA_CACHE
+	Newxz(cache, 1, SHACACHE);
+	if (!cacheopen(cache, file, rebuild)) {
+		Safefree(cache);
+		XSRETURN_UNDEF;
+	}
+	if (racy >= 0)
+		cache->racy = (W32) racy;
+	RETVAL = newSV(0);
+	sv_setref_pv(RETVAL, classname, (void *) cache);
+	SvREADONLY_on(SvRV(RETVAL));
+#else
+	PERL_UNUSED_VAR(classname);
+	PERL_UNUSED_VAR(file);
+	PERL_UNUSED_VAR(rebuild);
+	PERL_UNUSED_VAR(racy);
+	errno = ENOSYS;
+	XSRETURN_UNDEF;
+#endif
+OUTPUT:
+	RETVAL
+
+void
+DESTROY(self)
+	SV *	self
+PREINIT:
+#ifdef SHA_CACHE
+	SHACACHE *cache;
+#endif
+CODE:
+#ifdef SHA_CACHE
+	if ((cache = getCache(self)) != NULL) {
+		cacheclose(cache);
+		Safefree(cache);
+	}
+#else
+	PERL_UNUSED_VAR(self);
+#endif
+
+SV *
+_statkey(f)
+	SV *	f
+PREINIT:
+	struct stat st;
+	UCHR key[CACHE_KEY_LEN];
+	PerlIO *fp;
+	int ok;
+CODE:
+	if (SvTYPE(f) == SVt_PVGV || (SvROK(f) &&
+		(SvTYPE(SvRV(f)) == SVt_PVGV || SvTYPE(SvRV(f)) == SVt_PVIO))) {
+		fp = IoIFP(sv_2io(f));
+		ok = fp != NULL && fstat(PerlIO_fileno(fp), &st) == 0;
+	}
+	else
+		ok = SvOK(f) && stat(SvPV_nolen(f), &st) == 0;
+	if (!ok || !cachekey(&st, key))
+		XSRETURN_UNDEF;
+	RETVAL = newSVpv((char *) key, CACHE_KEY_LEN);
+OUTPUT:
+	RETVAL
+
+SV *
+get(self, key, alg, mode)
+	SV *	self
+	SV *	key
+	int	alg
+	char *	mode
+PREINIT:
+#ifdef SHA_CACHE
+	SHACACHE *cache;
+	UCHR *k;
+	STRLEN len;
+	UINT n;
+	UCHR state[SHA_MAX_STATE_LEN];
+#endif
+CODE:
+#ifdef SHA_CACHE
+	if ((cache = getCache(self)) == NULL)
+		XSRETURN_UNDEF;
+	k = (UCHR *) SvPVbyte(key, len);
+	if (len != CACHE_KEY_LEN)
+		XSRETURN_UNDEF;
+	if ((n = cacheget(cache, k, alg, *mode, state)) == 0)
+		XSRETURN_UNDEF;
+	RETVAL = newSVpv((char *) state, n);
+#else
+	PERL_UNUSED_VAR(self);
+	PERL_UNUSED_VAR(key);
+	PERL_UNUSED_VAR(alg);
+	PERL_UNUSED_VAR(mode);
+	XSRETURN_UNDEF;
+#endif
+OUTPUT:
+	RETVAL
+
+int
+put(self, key, alg, mode, state)
+	SV *	self
+	SV *	key
+	int	alg
+	char *	mode
+	SV *	state
+PREINIT:
+#ifdef SHA_CACHE
+	SHACACHE *cache;
+	UCHR *k, *data;
+	STRLEN klen, len;
+#endif
+CODE:
+	RETVAL = 0;
+#ifdef SHA_CACHE
+	if ((cache = getCache(self)) == NULL)
+		XSRETURN_UNDEF;
+	k = (UCHR *) SvPVbyte(key, klen);
+	data = (UCHR *) SvPVbyte(state, len);
+	if (klen == CACHE_KEY_LEN && len <= SHA_MAX_STATE_LEN)
+		RETVAL = cacheput(cache, k, alg, *mode, data, (UINT) len);
+#else
+	PERL_UNUSED_VAR(self);
+	PERL_UNUSED_VAR(key);
+	PERL_UNUSED_VAR(alg);
+	PERL_UNUSED_VAR(mode);
+	PERL_UNUSED_VAR(state);
+#endif
+OUTPUT:
+	RETVAL
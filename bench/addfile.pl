@@ -0,0 +1,91 @@
+#!perl
+
+	# addfile.pl: compare plain and pipelined addfile on a large file
+	#
+	# Usage: perl -Mblib bench/addfile.pl [-a alg] [-m MB] [file]
+	#
+	# Without a file argument, a scratch file of the given size
+	# (default 1024 MB) is created and removed afterwards.  For
+	# meaningful I/O numbers, run on a file that isn't in the page
+	# cache, e.g. after "echo 3 > /proc/sys/vm/drop_caches" on Linux.
+	#
+	# The "read" line times reading alone, and the "hash" line times
+	# hashing alone (from memory).  A pipelined addfile that overlaps
+	# I/O with hashing approaches max(read, hash) rather than their
+	# sum; the "overlap" line reports how close it comes (1.00 means
+	# fully overlapped, 0.00 means no better than read + hash).
+
+use strict;
+use warnings;
+use Fcntl;
+use Getopt::Std;
+use Time::HiRes qw(time);
+use Digest::SHA;
+
+my %opt;
+getopts('a:m:', \%opt) or die "usage: addfile.pl [-a alg] [-m MB] [file]\n";
+my $alg = $opt{a} || 256;
+my $MB = $opt{m} || 1024;
+
+my $file = shift;
+my $scratch;
+unless (defined $file) {
+	$file = $scratch = "addfile-bench.$$";
+	local *F;
+	sysopen(F, $file, O_WRONLY|O_CREAT|O_TRUNC) or die "$file: $!\n";
+	binmode(F);
+	my $chunk = join('', map { chr(rand(256)) } (1 .. 1 << 20));
+	print F $chunk for (1 .. $MB);
+	close(F);
+}
+END { unlink $scratch if defined $scratch }
+
+my $size = -s $file;
+my $mb = $size / (1 << 20);
+
+sub report {
+	my ($name, $secs) = @_;
+	printf("%-10s %9.1f MB/s %8.3f s\n", $name, $mb / $secs, $secs);
+	return $secs;
+}
+
+sub timeit {
+	my $code = shift;
+	my $t0 = time;
+	&$code;
+	return time - $t0;
+}
+
+my $tread = report("read", timeit(sub {
+	local *F;
+	my $buf;
+	sysopen(F, $file, O_RDONLY) or die "$file: $!\n";
+	1 while sysread(F, $buf, 1 << 20);
+	close(F);
+}));
+
+my $thash = report("hash", timeit(sub {
+	my $data = "\0" x (1 << 24);
+	my $sha = Digest::SHA->new($alg);
+	my $left = $size;
+	while ($left > 0) {
+		$sha->add($left >= length($data) ? $data :
+			substr($data, 0, $left));
+		$left -= length($data);
+	}
+	$sha->hexdigest;
+}));
+
+report("addfile", timeit(sub {
+	Digest::SHA->new($alg)->addfile($file, "b")->hexdigest;
+}));
+
+my $tpipe = report("pipeline", timeit(sub {
+	Digest::SHA->new($alg)->addfile($file, "b", { pipeline => 1 })
+		->hexdigest;
+}));
+
+my $best = $tread > $thash ? $tread : $thash;
+my $worst = $tread + $thash;
+printf("%-10s %9.2f\n", "overlap",
+	$worst > $best ? ($worst - $tpipe) / ($worst - $best) : 1);
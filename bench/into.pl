@@ -0,0 +1,51 @@
+#!perl
+
+	# into.pl: compare allocating digests with the *_into variants
+	#
+	# Usage: perl -Mblib bench/into.pl [-a alg] [-n count] [-l len]
+	#
+	# Each line hashes the same short message count times (default
+	# 1000000, of length 10) and reports the time per digest.  The
+	# "new" line builds an object per message; the "reuse" lines
+	# keep one object, relying on digest to reset it for the next
+	# message; the "into" lines write into one preallocated buffer
+	# instead of returning a new string each time.
+
+use strict;
+use warnings;
+use Getopt::Std;
+use Time::HiRes qw(time);
+use Digest::SHA;
+
+my %opt;
+getopts('a:n:l:', \%opt)
+	or die "usage: into.pl [-a alg] [-n count] [-l len]\n";
+my $alg = $opt{a} || 256;
+my $n = $opt{n} || 1000000;
+my $data = "x" x (defined $opt{l} ? $opt{l} : 10);
+
+my $fcn = Digest::SHA->can("sha$alg") or die "sha$alg: unsupported\n";
+my $fcninto = Digest::SHA->can("sha${alg}_into");
+my $hex = Digest::SHA->can("sha${alg}_hex");
+my $hexinto = Digest::SHA->can("sha${alg}_hex_into");
+
+sub report {
+	my ($name, $code) = @_;
+	my $t0 = time;
+	&$code;
+	printf("%-22s %8.0f ns\n", $name, (time - $t0) / $n * 1e9);
+}
+
+my ($d, $buf);
+my $sha = Digest::SHA->new($alg);
+
+report("sha$alg", sub { $d = &$fcn($data) for 1 .. $n });
+report("sha${alg}_into", sub { &$fcninto($buf, $data) for 1 .. $n });
+report("sha${alg}_hex", sub { $d = &$hex($data) for 1 .. $n });
+report("sha${alg}_hex_into", sub { &$hexinto($buf, $data) for 1 .. $n });
+report("new->add->digest", sub {
+	$d = Digest::SHA->new($alg)->add($data)->digest for 1 .. $n });
+report("reuse add->digest", sub {
+	$d = $sha->add($data)->digest for 1 .. $n });
+report("reuse add->digest_into", sub {
+	$sha->add($data)->digest_into($buf) for 1 .. $n });
@@ -0,0 +1,204 @@
+package Digest::SHA::Tree;
+
+require 5.003000;
+
+use strict;
+use warnings;
+use vars qw($VERSION);
+use Fcntl;
+
+require Digest::SHA;
+
+$VERSION = '5.94';
+
+sub new {
+	my($class, $alg, %opts) = @_;
+	$alg =~ s/\D+//g if defined $alg;
+	$alg = 1 unless defined $alg && length($alg);
+	my $leafsize = defined $opts{leaf_size} ? $opts{leaf_size} : 1 << 20;
+	return $class->_new($alg, $leafsize, $opts{jobs} || 0);
+}
+
+sub addfile {
+	my($self, $file) = @_;
+
+	local *FH;
+	if (ref(\$file) ne 'SCALAR') {
+		*FH = $file;
+	}
+	else {
+		$file eq '-' and open(FH, '< -')
+			or sysopen(FH, $file, O_RDONLY)
+				or Digest::SHA::_bail('Open failed');
+		binmode(FH);
+
+			## Regular files are mapped in windows of whole leaves,
+			## which are hashed in parallel; anything else is read
+			## in chunks large enough to keep the threads busy
+
+		my $done = $file ne '-' ? $self->_addfilemap(*FH) : undef;
+		Digest::SHA::_bail("Read failed") if defined($done) && !$done;
+		if ($done) {
+			close(FH);
+			return($self);
+		}
+	}
+
+	my($n, $buf) = (0, "");
+	my $size = $self->leaf_size * $self->jobs;
+	$size = 1 << 28 if $size > 1 << 28;
+	while (($n = read(FH, $buf, $size))) {
+		$self->add($buf);
+	}
+	Digest::SHA::_bail("Read failed") unless defined $n;
+	close(FH) if ref(\$file) eq 'SCALAR';
+
+	$self;
+}
+
+1;
+__END__
+
+=head1 NAME
+
+Digest::SHA::Tree - Parallel tree hashing with SHA
+
+=head1 SYNOPSIS
+
+ use Digest::SHA;
+
+ my $tree = Digest::SHA->new_tree(256, leaf_size => 1 << 20);
+
+ $tree->addfile("disk.img");
+ print $tree->hexdigest, "\n";
+
+ $tree->add($data);
+ $digest = $tree->digest;
+ $digest = $tree->b64digest;
+
+=head1 DESCRIPTION
+
+A SHA digest must be computed one block after another, so hashing a
+single large file can't go faster than one core allows.  A tree digest
+removes that limit: the message is cut into fixed-size leaves, the
+leaves are hashed independently on native worker threads, and their
+hashes are combined pairwise up to a single root.
+
+A tree digest is B<not> the same as the plain SHA digest of the same
+data, and it also depends on the leaf size.  Both sides of a
+comparison must therefore use tree mode with the same algorithm and
+leaf size.
+
+=head1 TREE FORMAT
+
+The format is fixed, so that digests can be compared across versions
+and with other implementations:
+
+=over 4
+
+=item *
+
+The message is split into consecutive leaves of I<leaf_size> bytes.
+The last leaf may be shorter; an empty message has a single, empty
+leaf.
+
+=item *
+
+A leaf hashes to H(0x00 || leaf), and an interior node to
+H(0x01 || left || right), where H is the chosen SHA algorithm.
+
+=item *
+
+A tree of n E<gt> 1 leaves has as its left subtree the first k
+leaves, where k is the largest power of two less than n, and the
+remaining leaves as its right subtree.
+
+=back
+
+This is the Merkle tree hash of RFC 6962, so e.g. Certificate
+Transparency tools compute the same root for the same leaves.  The
+0x00 and 0x01 prefixes keep leaf and node hashes from colliding.
+
+=head1 METHODS
+
+=over 4
+
+=item B<new($alg, %options)>
+
+=item B<Digest::SHA-E<gt>new_tree($alg, %options)>
+
+Returns a new tree digest object for algorithm I<$alg> (1, 224, 256,
+384, 512, 512224, or 512256; strings like "sha256" also work), or
+I<undef> if the algorithm or leaf size isn't supported.  The options
+are:
+
+	leaf_size => $bytes	# power of two, 1 KiB .. 1 GiB
+				# (default 1 MiB = 1048576)
+	jobs	  => $n		# threads (default: one per CPU)
+
+The default leaf size is part of the format: trees built with the
+default will always agree.  Larger leaves reduce the (small) cost of
+the interior nodes; smaller ones let short files use more threads.
+
+=item B<add($data, ...)>
+
+Logically joins the arguments into a single string and appends it to
+the message.  Complete leaves within the data are hashed in parallel.
+
+=item B<addfile($filename)>
+
+=item B<addfile(*FILE)>
+
+Appends the contents of a file, always read as raw bytes.  Named
+regular files are mapped into memory a group of leaves at a time, so
+their leaves are hashed in parallel without being copied; other files
+are read in chunks of I<leaf_size> times I<jobs> bytes (at most
+256 MiB).
+
+=item B<digest>
+
+=item B<hexdigest>
+
+=item B<b64digest>
+
+Returns the root hash, encoded as a binary, hexadecimal, or Base64
+string, and resets the object so it can hash another message.  As
+with L<Digest::SHA>, the Base64 form is unpadded.
+
+=item B<reset>
+
+Discards any data added so far.
+
+=item B<algorithm>
+
+=item B<hashsize>
+
+=item B<leaf_size>
+
+=item B<jobs>
+
+Return the object's SHA algorithm, the number of bits in its digest,
+its leaf size in bytes, and the number of threads it uses.
+
+=back
+
+=head1 SEE ALSO
+
+L<Digest::SHA>, L<shasum>
+
+RFC 6962, section 2.1: L<https://tools.ietf.org/html/rfc6962#section-2.1>
+
+=head1 AUTHOR
+
+Mark Shelor <mshelor@cpan.org>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2003-2014 Mark Shelor
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself.
+
+L<perlartistic>
+
+=cut
@@ -8,7 +8,7 @@ use vars qw($VERSION @ISA @EXPORT @EXPORT_OK);
 use Fcntl;
 use integer;
 
-$VERSION = '5.93';
+$VERSION = '5.94';
 
 require Exporter;
 require DynaLoader;
@@ -27,7 +27,26 @@ require DynaLoader;
 	sha384		sha384_base64		sha384_hex
 	sha512		sha512_base64		sha512_hex
 	sha512224	sha512224_base64	sha512224_hex
-	sha512256	sha512256_base64	sha512256_hex);
+	sha512256	sha512256_base64	sha512256_hex
+	sha1_many	sha1_base64_many	sha1_hex_many
+	sha224_many	sha224_base64_many	sha224_hex_many
+	sha256_many	sha256_base64_many	sha256_hex_many
+	sha384_many	sha384_base64_many	sha384_hex_many
+	sha512_many	sha512_base64_many	sha512_hex_many
+	sha512224_many	sha512224_base64_many	sha512224_hex_many
+	sha512256_many	sha512256_base64_many	sha512256_hex_many
+	sha1_into	sha1_base64_into	sha1_hex_into
+	sha224_into	sha224_base64_into	sha224_hex_into
+	sha256_into	sha256_base64_into	sha256_hex_into
+	sha384_into	sha384_base64_into	sha384_hex_into
+	sha512_into	sha512_base64_into	sha512_hex_into
+	sha512224_into	sha512224_base64_into	sha512224_hex_into
+	sha512256_into	sha512256_base64_into	sha512256_hex_into
+	digest_files
+	pbkdf2		hkdf			hkdf_extract
+	hkdf_expand	save_states		load_states
+	async_fd	async_poll		async_wait
+	async_pending	async_threads);
 
 # Inherit from Digest::base if possible
 
@@ -54,6 +73,12 @@ sub new {
 
 BEGIN { *reset = \&new }
 
+sub new_tree {
+	my($class, $alg, %opts) = @_;
+	require Digest::SHA::Tree;
+	return Digest::SHA::Tree->new($alg, %opts);
+}
+
 sub add_bits {
 	my($self, $data, $nbits) = @_;
 	unless (defined $nbits) {
@@ -104,14 +129,32 @@ sub _addfile {
 	$self;
 }
 
+	## _cachetag: returns the cache key of FH and the mode under which
+	## its state is cached, or nothing if the state can't be cached,
+	## i.e. data has already been added, or text mode reads through
+	## I/O layers that might alter the bytes
+
+sub _cachetag {
+	my ($self, $fh, $mode) = @_;
+
+	return unless substr($self->_getstate, -20) eq "\0" x 20;
+	if ($mode eq "") {
+		return unless defined &PerlIO::get_layers;
+		return if grep { !/^(unix|perlio|stdio)$/ }
+			PerlIO::get_layers($fh);
+		$mode = "b";
+	}
+	my $key = Digest::SHA::Cache::_statkey($fh) or return;
+	return($key, $mode);
+}
+
 sub addfile {
-	my ($self, $file, $mode) = @_;
+	my ($self, $file, $mode, $opts) = @_;
 
 	return(_addfile($self, $file)) unless ref(\$file) eq 'SCALAR';
 
 	$mode = defined($mode) ? $mode : "";
-	my ($binary, $UNIVERSAL, $BITS, $portable) =
-		map { $_ eq $mode } ("b", "U", "0", "p");
+	my $BITS = $mode eq "0";
 
 		## Always interpret "-" to mean STDIN; otherwise use
 		## sysopen to handle full range of POSIX file names
@@ -121,6 +164,19 @@ sub addfile {
 		or sysopen(FH, $file, O_RDONLY)
 			or _bail('Open failed');
 
+		## A cached state for an unchanged file replaces reading it;
+		## otherwise the new state is cached if the file stayed put
+
+	my $cache = ref($opts) && $file ne '-' ? $opts->{cache} : undef;
+	my ($key, $tag) = $cache ? _cachetag($self, *FH, $mode) : ();
+	if (defined $key) {
+		my $state = $cache->get($key, $self->algorithm, $tag);
+		if (defined $state && $self->_putstate($state)) {
+			close(FH);
+			return($self);
+		}
+	}
+
 	if ($BITS) {
 		my ($n, $buf) = (0, "");
 		while (($n = read(FH, $buf, 4096))) {
@@ -128,25 +184,204 @@ sub addfile {
 			$self->add_bits($buf);
 		}
 		_bail("Read failed") unless defined $n;
-		close(FH);
-		return($self);
 	}
+	else {
+		_addfilemode($self, *FH, $file, $mode, $opts);
+	}
+	if (defined $key) {
+		my $now = Digest::SHA::Cache::_statkey(*FH);
+		$cache->put($key, $self->algorithm, $tag, $self->_getstate)
+			if defined $now && $now eq $key;
+	}
+	close(FH);
+
+	$self;
+}
+
+sub _addfilemode {
+	my ($self, $fh, $file, $mode, $opts) = @_;
+	my ($binary, $UNIVERSAL, $portable) =
+		map { $_ eq $mode } ("b", "U", "p");
 
+	local *FH = $fh;
 	binmode(FH) if $binary || $portable || $UNIVERSAL;
-	if ($UNIVERSAL && _istext(*FH, $file)) {
-		$self->_addfileuniv(*FH);
+	if (($UNIVERSAL || $portable) && _istext(*FH, $file)) {
+		$self->_addfileuniv(*FH, $portable ? 1 : 0);
 	}
-	elsif ($portable && _istext(*FH, $file)) {
-		while (<FH>) {
-			s/\015?\015\012/\012/g;
-			s/\015/\012/g;
-			$self->add($_);
+	else {
+			## Use the pipelined reader if requested, or else map
+			## regular files into memory when reading raw bytes;
+			## both return undef if they can't be used for this
+			## file, or false if reading failed part way through
+
+		my $raw = ($binary || $portable || $UNIVERSAL) && $file ne '-';
+		my $done;
+		$done = $self->_addfilepipe(*FH, $opts->{buffers} || 0,
+				$opts->{bufsize} || 0)
+			if $raw && ref($opts) && $opts->{pipeline};
+		$done = $self->_addfilemap(*FH) if $raw && !defined($done);
+		_bail("Read failed") if defined($done) && !$done;
+		$self->_addfilebin(*FH) unless $done;
+	}
+}
+
+	## Background hashing: %_ASYNC maps the id of each pending job to
+	## its object and callback; the objects stay alive until then.
+	## Ids are private to each interpreter, so a new thread starts
+	## with no pending jobs.
+
+my %_ASYNC;
+
+sub CLONE {
+	%_ASYNC = ();
+}
+
+sub addfile_async {
+	my ($self, $file, $cb) = @_;
+
+	my ($path, $fd, $pos) = (undef, -1, -1);
+	if (ref(\$file) eq 'SCALAR') {
+		$path = $file;
+	}
+	else {
+		$fd = fileno($file);
+		return unless defined $fd && $fd >= 0;
+		$pos = tell($file);
+	}
+	my $id = _async_submit($self, $path, $fd, $pos) or return;
+	$_ASYNC{$id} = [$self, $cb];
+	async_poll() unless defined async_fd();
+	return($self);
+}
+
+sub async_poll {
+	my $n = 0;
+	for my $id (_async_reap()) {
+		my $job = delete $_ASYNC{$id};
+		my $err = _async_finish($job ? $job->[0] : undef, $id);
+		next unless $job && defined $err;
+		$n++;
+		next unless $job->[1];
+		local $! = $err;
+		$job->[1]->($err ? (undef, "$!") : ($job->[0]));
+	}
+	return($n);
+}
+
+sub async_pending {
+	return(scalar(keys %_ASYNC));
+}
+
+sub async_wait {
+	my $n = 0;
+	my $fd = async_fd();
+	while (%_ASYNC) {
+		if (defined $fd) {
+			my $rin = "";
+			vec($rin, $fd, 1) = 1;
+			select($rin, undef, undef, undef);
 		}
+		$n += async_poll();
 	}
-	else { $self->_addfilebin(*FH) }
-	close(FH);
+	return($n);
+}
 
-	$self;
+sub digest_files {
+	my($alg, $paths, $opts) = @_;
+
+	$alg =~ s/\D+//g if defined $alg;
+	$alg = 1 unless defined $alg && length($alg);
+	return unless ref($paths) eq 'ARRAY';
+	$opts = {} unless ref($opts) eq 'HASH';
+	my $format = {hex => 1, base64 => 2, binary => 0}
+		->{defined $opts->{format} ? $opts->{format} : "hex"};
+	return unless defined $format;
+	my $cache = $opts->{cache};
+
+		## With a cache, only files lacking a current entry are read,
+		## and their unfinished states are returned so they can be
+		## saved if the files didn't change meanwhile
+
+	my(%digest, @todo, @keys);
+	for my $path (@$paths) {
+		my $key = $cache ? Digest::SHA::Cache::_statkey($path) : undef;
+		my $state = defined $key ? $cache->get($key, $alg, "b") : undef;
+		my $d = defined $state ? _statedigest($alg, $state, $format) : undef;
+		if (defined $d) {
+			$digest{$path} = $d;
+			next;
+		}
+		push(@todo, $path);
+		push(@keys, $key);
+	}
+	my($digests, $errs) =
+		_digestfiles($alg, \@todo, $opts->{jobs} || 1, $cache ? 3 : $format)
+			or return;
+
+	for my $i (0 .. $#todo) {
+		my($path, $d) = ($todo[$i], $digests->[$i]);
+		if ($cache && defined $d) {
+			my $now = Digest::SHA::Cache::_statkey($path);
+			$cache->put($keys[$i], $alg, "b", $d) if defined $keys[$i]
+				&& defined $now && $now eq $keys[$i];
+			$d = _statedigest($alg, $d, $format);
+		}
+		$digest{$path} = $d;
+		next if defined $d || ref($opts->{errors}) ne 'HASH';
+		local $! = $errs->[$i];
+		$opts->{errors}->{$path} = "$!";
+	}
+	return(\%digest);
+}
+
+## Key derivation: the iterations and HMAC pad states are handled in C,
+## so these just normalize the algorithm and fill in default lengths
+
+sub _kdfalg {
+	my $alg = shift;
+
+	$alg =~ s/\D+//g if defined $alg;
+	return unless defined $alg && length($alg);
+	my $sha = Digest::SHA->new($alg) or return;
+	return($alg, $sha->hashsize >> 3);
+}
+
+sub pbkdf2 {
+	my($alg, $password, $salt, $iterations, $dklen) = @_;
+
+	my($n, $hlen) = _kdfalg($alg) or return;
+	$salt = "" unless defined $salt;
+	$iterations = 1 unless defined $iterations;
+	$dklen = $hlen unless defined $dklen;
+	return unless $iterations >= 1 && $dklen >= 0;
+	_pbkdf2($n, defined $password ? $password : "", $salt,
+		$iterations, $dklen);
+}
+
+sub hkdf_extract {
+	my($alg, $salt, $ikm) = @_;
+
+	my($n) = _kdfalg($alg) or return;
+	_hkdfextract($n, defined $salt ? $salt : "",
+		defined $ikm ? $ikm : "");
+}
+
+sub hkdf_expand {
+	my($alg, $prk, $info, $len) = @_;
+
+	my($n, $hlen) = _kdfalg($alg) or return;
+	$len = $hlen unless defined $len;
+	return unless $len >= 0 && $len <= 255 * $hlen;
+	_hkdfexpand($n, defined $prk ? $prk : "",
+		defined $info ? $info : "", $len);
+}
+
+sub hkdf {
+	my($alg, $ikm, $salt, $info, $len) = @_;
+
+	my $prk = hkdf_extract($alg, $salt, $ikm);
+	return unless defined $prk;
+	hkdf_expand($alg, $prk, $info, $len);
 }
 
 sub getstate {
@@ -214,6 +449,14 @@ sub putstate {
 	return $class->new($s{'alg'})->_putstate($packed_state);
 }
 
+sub resume {
+	my($class, $ckpt) = @_;
+
+	my $self = ref($class) ? $class : $class->new;
+	return unless defined $self;
+	return $self->_resume($ckpt);
+}
+
 sub dump {
 	my $self = shift;
 	my $file = shift;
@@ -425,10 +668,10 @@ By convention, CPAN Digest modules do B<not> pad their Base64 output.
 Problems can occur when feeding such digests to other software that
 expects properly padded Base64 encodings.
 
-For the time being, any necessary padding must be done by the user.
-Fortunately, this is a simple operation: if the length of a Base64-encoded
-digest isn't a multiple of 4, simply append "=" characters to the end
-of the digest until it is:
+The OO interface can supply the padding itself: see I<b64digest>.
+Otherwise, padding is a simple operation: if the length of a
+Base64-encoded digest isn't a multiple of 4, simply append "="
+characters to the end of the digest until it is:
 
 	while (length($b64_digest) % 4) {
 		$b64_digest .= '=';
@@ -514,6 +757,142 @@ the padding characters typical of Base64 encodings.  This omission is
 deliberate, and is done to maintain compatibility with the family of
 CPAN Digest modules.  See L</"PADDING OF BASE64 DIGESTS"> for details.
 
+=item B<sha1_many(\@data)>
+
+=item B<sha224_many(\@data)>
+
+=item B<sha256_many(\@data)>
+
+=item B<sha384_many(\@data)>
+
+=item B<sha512_many(\@data)>
+
+=item B<sha512224_many(\@data)>
+
+=item B<sha512256_many(\@data)>
+
+=item B<sha1_hex_many(\@data)>
+
+=item B<sha224_hex_many(\@data)>
+
+=item B<sha256_hex_many(\@data)>
+
+=item B<sha384_hex_many(\@data)>
+
+=item B<sha512_hex_many(\@data)>
+
+=item B<sha512224_hex_many(\@data)>
+
+=item B<sha512256_hex_many(\@data)>
+
+=item B<sha1_base64_many(\@data)>
+
+=item B<sha224_base64_many(\@data)>
+
+=item B<sha256_base64_many(\@data)>
+
+=item B<sha384_base64_many(\@data)>
+
+=item B<sha512_base64_many(\@data)>
+
+=item B<sha512224_base64_many(\@data)>
+
+=item B<sha512256_base64_many(\@data)>
+
+Returns a list containing the digest of each element of I<@data>,
+in order, encoded as a binary, hexadecimal, or Base64 string.  The
+result is the same as calling the corresponding one-shot function on
+every element, but the messages are hashed in a single call.  On CPUs
+with AVX2 but without the SHA extensions, the SHA-1/224/256 variants
+hash up to eight messages at once in parallel SIMD lanes, which makes
+these functions much faster for large numbers of short messages.
+
+=item B<sha1_into($buf, $data, ...)>
+
+=item B<sha224_into($buf, $data, ...)>
+
+=item B<sha256_into($buf, $data, ...)>
+
+=item B<sha384_into($buf, $data, ...)>
+
+=item B<sha512_into($buf, $data, ...)>
+
+=item B<sha512224_into($buf, $data, ...)>
+
+=item B<sha512256_into($buf, $data, ...)>
+
+=item B<sha1_hex_into($buf, $data, ...)>
+
+=item B<sha224_hex_into($buf, $data, ...)>
+
+=item B<sha256_hex_into($buf, $data, ...)>
+
+=item B<sha384_hex_into($buf, $data, ...)>
+
+=item B<sha512_hex_into($buf, $data, ...)>
+
+=item B<sha512224_hex_into($buf, $data, ...)>
+
+=item B<sha512256_hex_into($buf, $data, ...)>
+
+=item B<sha1_base64_into($buf, $data, ...)>
+
+=item B<sha224_base64_into($buf, $data, ...)>
+
+=item B<sha256_base64_into($buf, $data, ...)>
+
+=item B<sha384_base64_into($buf, $data, ...)>
+
+=item B<sha512_base64_into($buf, $data, ...)>
+
+=item B<sha512224_base64_into($buf, $data, ...)>
+
+=item B<sha512256_base64_into($buf, $data, ...)>
+
+Like the corresponding one-shot functions, but the digest is written
+into the scalar I<$buf>, replacing its contents, rather than returned
+as a new string.  The buffer is reused as is when it's large enough,
+so a loop that hashes many messages into the same I<$buf> allocates
+nothing per message.  Returns the length of the digest written, or
+I<undef> if I<$buf> is read-only or holds wide characters.
+
+	my $buf;
+	for my $token (@tokens) {
+		sha256_into($buf, $token);
+		...
+	}
+
+=item B<digest_files($alg, \@paths [, \%options])>
+
+Computes the digest of every file named in I<@paths> using algorithm
+I<$alg> (e.g. 256 or "sha256"), and returns a reference to a hash that
+maps each path to its digest.  Opening, reading, and hashing are all
+done in C, with each file read as raw bytes (like I<addfile> in "b"
+mode), so there's no per-file object, I<sysopen>, or I<-T> test.
+
+A file that can't be opened or read doesn't stop the others: its path
+maps to I<undef>, and the error message is stored in the I<errors>
+hash if one is given.  The options are:
+
+	jobs	=> $n		# hash up to $n files at a time (default 1)
+	format	=> "hex"	# or "base64" or "binary" (default "hex")
+	errors	=> \%errors	# receives path => error message
+	cache	=> $cache	# a Digest::SHA::Cache object
+
+For example:
+
+	my %err;
+	my $sums = digest_files(256, \@files, { jobs => 4, errors => \%err });
+	print "$sums->{$_}  $_\n" for grep { defined $sums->{$_} } @files;
+	warn "$_: $err{$_}\n" for sort keys %err;
+
+The I<jobs> option spreads the files over native threads when the
+module is built with thread support; otherwise it has no effect.
+With a I<cache>, files that haven't changed since their digests were
+cached aren't read at all (ref. I<addfile>).
+Returns I<undef> if I<$alg> or the I<format> isn't recognized, or if
+I<@paths> isn't an array reference.
+
 =back
 
 I<OOP style>
@@ -533,6 +912,15 @@ initial state associated with I<$alg>.  If the argument is missing,
 the object will continue using the same algorithm that was selected
 at creation.
 
+=item B<new_tree($alg [, leaf_size =E<gt> $bytes, jobs =E<gt> $n])>
+
+Returns a new L<Digest::SHA::Tree> object, which computes a tree
+(Merkle) digest: fixed-size leaves of the message are hashed on
+native threads, and their hashes are combined into a single root.
+This lets one very large file be hashed on all cores, but the result
+differs from the ordinary digest of the same data.  See
+L<Digest::SHA::Tree> for the exact format.
+
 =item B<reset($alg)>
 
 This method has exactly the same effect as I<new($alg)>.  In fact,
@@ -554,6 +942,37 @@ SHA-384, SHA-512, SHA-512/224, and SHA-512/256, respectively.
 
 Returns a duplicate copy of the object.
 
+=item B<stats>
+
+=item B<global_stats>
+
+When Digest::SHA is built with statistics (I<perl Makefile.PL -s>, or
+-DSHA_STATS), I<stats> returns a reference to a hash of counters for
+the object, and I<Digest::SHA::global_stats()> the same counters summed
+over every state used by the process, including the temporary ones
+behind the functional interface and the worker threads.  Otherwise
+both return I<undef>, and the counters cost nothing.
+
+	blocks		blocks compressed
+	direct		bytes compressed straight from the caller's data
+	bytes		bytes first copied into the block buffer
+	bits		bytes shifted into the buffer (bit-aligned data)
+	partial		copies into the block buffer
+	finish		digests finished
+	reads		reads and mapped windows of files
+	readbytes	bytes read or mapped
+
+An object's counters survive I<digest> and I<reset>, and are cleared
+only when it changes algorithm.  When hashing is slower than expected,
+a large I<bytes> or I<partial> count relative to I<direct> points to
+many small or unaligned I<add> calls, a nonzero I<bits> to data that
+doesn't start on a byte boundary, and a low I<readbytes>/I<reads>
+ratio to small reads in I<addfile>:
+
+	my $st = $sha->stats;
+	printf("%.1f%% copied\n", 100 * $st->{bytes} /
+		($st->{bytes} + $st->{direct} || 1));
+
 =item B<add($data, ...)>
 
 Logically joins the arguments into a single string, and uses it to
@@ -593,7 +1012,7 @@ So, the following two statements do the same thing:
 Reads from I<FILE> until EOF, and appends that data to the current
 state.  The return value is the updated object itself.
 
-=item B<addfile($filename [, $mode])>
+=item B<addfile($filename [, $mode [, \%options]])>
 
 Reads the contents of I<$filename>, and appends that data to the current
 state.  The return value is the updated object itself.
@@ -630,6 +1049,95 @@ a convenient way to calculate the digest values of partial-byte data
 by using files, rather than having to write separate programs employing
 the I<add_bits> method.
 
+When the data is read as raw bytes (i.e. in "b" mode, or in "U" or "p"
+mode for a file that isn't text), regular files are mapped into memory
+and hashed in place, which avoids a copy and most of the read calls
+for large files.  Pipes, STDIN, and files that can't be mapped are read
+in the usual way.  As with any memory-mapped file, truncating the file
+while it's being hashed may cause the process to receive SIGBUS.
+
+The optional I<\%options> argument tunes how raw bytes are read.  With
+
+	$sha->addfile($filename, "b", { pipeline => 1 });
+
+a native reader thread fills a ring of large buffers ahead of the
+hashing, so that disk I/O and hashing overlap instead of alternating.
+This helps most when the file isn't already cached and the storage is
+about as fast as the hash.  The ring defaults to 4 buffers of 1 MB,
+which can be changed with the I<buffers> and I<bufsize> options.  If
+the module was built without thread support, or the file can't be
+read this way, I<addfile> silently falls back to its usual method.
+Thread support is built in if perl itself is threaded, or if the
+module is configured with "perl Makefile.PL -p".
+
+A I<cache> option, holding a L<Digest::SHA::Cache> object, lets
+I<addfile> skip reading files it has seen before:
+
+	my $cache = Digest::SHA::Cache->new($cachefile);
+	$sha->addfile($filename, "b", { cache => $cache });
+
+If the cache has a state for I<$filename> in this mode, and the file's
+size and timestamps haven't changed since, that state is loaded in
+place of reading the file.  Otherwise the file is read as usual and
+the resulting state is saved.  The cache is consulted only when the
+object is fresh (no data added yet), and not for STDIN.
+
+=item B<addfile_async($filename [, $callback])>
+
+=item B<addfile_async(*FILE [, $callback])>
+
+Like I<addfile> in binary mode, but the file is read and hashed on a
+background thread, so that an event loop isn't held up by large
+files.  The call returns the object at once (or I<undef>, setting $!,
+if the job couldn't be started); later, I<async_poll> calls
+I<$callback> with the updated object, or with I<undef> and the error
+message if the file couldn't be read.  An open handle is read from
+its current position, and its position afterward is unspecified.
+
+The job hashes a copy of the object's state, which replaces the
+object's state when the job is collected, so the object shouldn't
+be used in the meantime.  Jobs from all objects share one pool of
+at most I<async_threads> threads, and wait their turn if all the
+threads are busy.  Without thread support, the file is hashed before
+I<addfile_async> returns, and the callback is called from there.
+
+=item B<async_fd>
+
+Returns a file descriptor that becomes readable when background jobs
+have finished, for an event loop to watch; I<undef> without thread
+support.  When it's readable, call I<async_poll>:
+
+	my $w = AnyEvent->io(fh => Digest::SHA::async_fd(), poll => "r",
+		cb => \&Digest::SHA::async_poll);
+
+	$sha->addfile_async($upload, sub {
+		my ($sha, $err) = @_;
+		defined $sha ? reply($sha->hexdigest) : fail($err);
+	});
+
+=item B<async_poll>
+
+Collects all finished background jobs and calls their callbacks.
+Returns the number of jobs collected; it never waits.
+
+=item B<async_wait>
+
+Waits for all pending background jobs, calling their callbacks, and
+returns the number of jobs collected.
+
+=item B<async_pending>
+
+Returns the number of background jobs whose callbacks haven't run.
+
+=item B<async_threads([$n])>
+
+Returns the most threads the background pool may use (by default,
+one per processor), after setting it to I<$n> if given.  Threads are
+started only as needed, and stay for the life of the process.  Jobs
+still running when the process forks are finished in the parent only.
+Under ithreads, the pool is shared, but each thread collects (and
+waits for) only the jobs that it started.
+
 =item B<getstate>
 
 Returns a string containing a portable, human-readable representation
@@ -643,6 +1151,48 @@ produced by method I<getstate>.  If called as a class method, a new
 object is created; if called as an instance method, the object is reset
 to the state contained in I<$str>.
 
+=item B<checkpoint>
+
+Returns the current SHA state as a 256-byte binary string.  Unlike
+I<getstate>, a checkpoint needs no formatting or parsing: it holds
+the packed state together with a format version and a CRC-32, so
+that a damaged or truncated checkpoint is detected rather than
+silently resumed.  Every checkpoint has the same length, whatever
+the algorithm.  Checkpoints are portable between platforms, but are
+not meant to be read by people; use I<getstate> for that.
+
+=item B<resume($ckpt)>
+
+Returns a Digest::SHA object holding the state saved in I<$ckpt> by
+I<checkpoint>, taking the algorithm from the checkpoint.  As with
+I<putstate>, a class method creates a new object, and an instance
+method replaces the state of the object.  Returns I<undef>, leaving
+the object alone, if I<$ckpt> isn't a valid checkpoint.
+
+	my $ckpt = $sha->checkpoint;
+	...
+	my $sha = Digest::SHA->resume($ckpt) or die "bad checkpoint";
+
+=item B<save_states($filename, @states)>
+
+Writes checkpoints of all the Digest::SHA objects in I<@states> to
+a new file, by mapping the file into memory and filling it in place,
+and returns the number of states saved.  Returns I<undef> if the file
+can't be written (setting $!) or an argument isn't a Digest::SHA
+object.  The file is replaced, not updated, so save to a temporary
+name and rename it when an older copy must survive a crash.
+
+=item B<load_states($filename)>
+
+Returns a list of Digest::SHA objects, one for each checkpoint in a
+file written by I<save_states>, in the same order.  An element is
+I<undef> if its checkpoint is damaged, so the others can still be
+used.  Returns an empty list, setting $!, if the file can't be read
+or isn't a file of checkpoints.
+
+	save_states("uploads.ckpt", values %inflight) or die $!;
+	my @states = load_states("uploads.ckpt");
+
 =item B<dump($filename)>
 
 Writes the output of I<getstate> to I<$filename>.  If the argument is
@@ -675,6 +1225,8 @@ the original digest state.
 
 =item B<b64digest>
 
+=item B<b64digest(url =E<gt> $bool, pad =E<gt> $bool)>
+
 Returns the digest encoded as a Base64 string.
 
 Like I<digest>, this method is a read-once operation.  Call
@@ -686,6 +1238,43 @@ the padding characters typical of Base64 encodings.  This omission is
 deliberate, and is done to maintain compatibility with the family of
 CPAN Digest modules.  See L</"PADDING OF BASE64 DIGESTS"> for details.
 
+The optional arguments change this: I<pad> appends the "=" padding
+characters, and I<url> uses the URL and filename safe alphabet of
+RFC 4648, with "-" and "_" in place of "+" and "/".  An unknown option
+causes I<b64digest> to return I<undef> without disturbing the digest
+state; so do any options given to I<digest> or I<hexdigest>.
+
+	$sha->b64digest(url => 1)		# for URLs and JWTs
+	$sha->b64digest(pad => 1)		# standard Base64
+
+=item B<digest_into($buf [, $offset])>
+
+=item B<hexdigest_into($buf [, $offset])>
+
+=item B<b64digest_into($buf [, $offset])>
+
+Like I<digest>, I<hexdigest>, and I<b64digest>, but the result is
+written into the scalar I<$buf> at I<$offset> (default 0), in the
+manner of I<sysread>: the bytes before I<$offset> are kept (padded
+with "\0" if I<$buf> is shorter), and I<$buf> ends where the digest
+does.  The buffer is only reallocated if it's too small.  Returns
+the length of the digest written, or I<undef> if I<$buf> is read-only,
+holds wide characters, or I<$offset> is negative; in that case the
+digest state is left alone.
+
+Because every digest method resets the object, one object can be
+reused for a whole stream of messages.  Together with a reused buffer,
+this avoids allocating anything per message:
+
+	my $sha = Digest::SHA->new(256);
+	my $buf;
+	for my $msg (@messages) {
+		$sha->add($msg)->digest_into($buf);
+		...
+	}
+
+See F<bench/into.pl> for a comparison with the allocating methods.
+
 =back
 
 I<HMAC-SHA-1/224/256/384/512>
@@ -756,9 +1345,50 @@ CPAN Digest modules.  See L</"PADDING OF BASE64 DIGESTS"> for details.
 
 =back
 
+When many messages are signed with the same key, a L<Digest::SHA::HMAC>
+object avoids rehashing the key for every message.
+
+I<Key derivation>
+
+=over 4
+
+=item B<pbkdf2($alg, $password, $salt, $iterations [, $dklen])>
+
+Returns I<$dklen> bytes (by default, the digest length of I<$alg>)
+derived from I<$password> and I<$salt> using PBKDF2 with HMAC-SHA-I<$alg>
+as the pseudorandom function (ref. RFC 8018).  I<$alg> may be any of
+the algorithms accepted by I<new>.  The iterations are done entirely
+in C, starting each HMAC from the key's precomputed pad states, so
+a large iteration count costs little more than two compressions per
+iteration.  Returns I<undef> if I<$alg> isn't recognized or
+I<$iterations> is less than 1.
+
+	my $dk = pbkdf2(256, $password, $salt, 100000, 32);
+
+=item B<hkdf($alg, $ikm, $salt, $info [, $len])>
+
+Returns I<$len> bytes (by default, the digest length of I<$alg>) of
+output keying material derived from the input keying material I<$ikm>
+using HKDF with HMAC-SHA-I<$alg> (ref. RFC 5869).  An empty or undefined
+I<$salt> is treated as a string of zero bytes, as the RFC requires.
+I<$len> may be at most 255 times the digest length; I<undef> is returned
+otherwise.
+
+=item B<hkdf_extract($alg, $salt, $ikm)>
+
+=item B<hkdf_expand($alg, $prk, $info [, $len])>
+
+The two steps of I<hkdf>, for callers that derive several keys from
+one pseudorandom key: I<hkdf_extract> returns the pseudorandom key
+I<$prk>, and I<hkdf_expand> expands it into I<$len> bytes bound to
+I<$info>.
+
+=back
+
 =head1 SEE ALSO
 
-L<Digest>, L<Digest::SHA::PurePerl>
+L<Digest>, L<Digest::SHA::PurePerl>, L<Digest::SHA::Cache>,
+L<Digest::SHA::CDC>, L<Digest::SHA::HMAC>, L<Digest::SHA::Tree>
 
 The Secure Hash Standard (Draft FIPS PUB 180-4) can be found at:
 
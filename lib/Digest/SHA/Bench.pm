@@ -0,0 +1,299 @@
+package Digest::SHA::Bench;
+
+require 5.003000;
+
+use strict;
+use warnings;
+use vars qw($VERSION @SIZES @TESTS);
+use Fcntl;
+use Config qw(%Config);
+use File::Spec;
+use Time::HiRes qw(time);
+
+require Digest::SHA;
+
+$VERSION = '5.94';
+
+@SIZES = (0, 16, 64, 256, 1 << 10, 1 << 12, 1 << 16, 1 << 20,
+	1 << 24, 1 << 26, 1 << 28, 1 << 30);
+@TESTS = qw(oneshot add hmac addfile hex base64);
+
+my @ALGS = (1, 224, 256, 384, 512, 512224, 512256);
+my @COLS = qw(test alg bytes iters secs ns_per_op mb_per_s cycles_per_byte);
+
+## size: converts "16M", "1G", etc. to a byte count
+
+sub size {
+	my($s) = @_;
+	return unless defined $s && $s =~ /^(\d+)\s*([KMG]?)B?$/i;
+	return $1 * {'' => 1, K => 1 << 10, M => 1 << 20, G => 1 << 30}
+		->{uc $2};
+}
+
+## timeit: calls &$code($n) with a growing $n until it runs for at
+## least $mintime seconds; returns ($n, seconds, cycles)
+
+sub timeit {
+	my($code, $mintime) = @_;
+	my $n = 1;
+	for (;;) {
+		my $c0 = Digest::SHA::_cycles();
+		my $t0 = time;
+		&$code($n);
+		my $secs = time - $t0;
+		my $cycles = Digest::SHA::_cycles() - $c0;
+		return($n, $secs, $cycles)
+			if $secs >= $mintime || $n >= 1 << 30;
+		my $k = $secs > 0 ? int(1.2 * $mintime / $secs) + 1 : 100;
+		$n *= $k < 2 ? 2 : ($k > 100 ? 100 : $k);
+	}
+}
+
+## bench: returns a sub that runs one test $n times on $data
+
+sub bench {
+	my($test, $alg, $data, $file) = @_;
+	my $key = "k" x 32;
+
+	if ($test eq 'oneshot' || $test eq 'hex' || $test eq 'base64') {
+		my $suffix = $test eq 'oneshot' ? '' : "_$test";
+		my $f = Digest::SHA->can("sha$alg$suffix");
+		return sub { my $n = shift; &$f($data) for 1 .. $n };
+	}
+	if ($test eq 'hmac') {
+		my $f = Digest::SHA->can("hmac_sha$alg");
+		return sub { my $n = shift; &$f($data, $key) for 1 .. $n };
+	}
+	my $sha = Digest::SHA->new($alg);
+	if ($test eq 'add') {
+		return sub { my $n = shift; $sha->add($data)->digest for 1 .. $n };
+	}
+	return sub {
+		my $n = shift;
+		$sha->addfile($file, "b")->digest for 1 .. $n;
+	};
+}
+
+## header: returns the '#' lines that describe this run
+
+sub header {
+	my $cycles = Digest::SHA::_cycles() ? "tsc" : "none";
+	return(
+		"# Digest::SHA $Digest::SHA::VERSION",
+		"# perl " . (defined $^V ? sprintf("%vd", $^V) : $]) .
+			" $Config{archname}",
+		"# cc $Config{cc} $Config{optimize}",
+		sprintf("# cpu features 0x%02x", Digest::SHA::_cpuid()),
+		"# cycles $cycles",
+		join("\t", @COLS),
+	);
+}
+
+## row: formats one result as a tab-separated line
+
+sub row {
+	my($r) = @_;
+	return join("\t", map { defined $r->{$_} ? $r->{$_} : "-" } @COLS);
+}
+
+## tmpfile: creates a scratch file holding $data, for addfile
+
+sub tmpfile {
+	my($data) = @_;
+	my $file = File::Spec->catfile(File::Spec->tmpdir,
+		"sha-bench.$$." . length($data));
+	local *F;
+	sysopen(F, $file, O_WRONLY|O_CREAT|O_TRUNC) or return;
+	binmode(F);
+	my $ok = print F $data;
+	close(F) or $ok = 0;
+	unlink($file), return unless $ok;
+	return($file);
+}
+
+sub run {
+	my(%opts) = @_;
+	my $mintime = defined $opts{mintime} ? $opts{mintime} : 0.2;
+	my @algs = $opts{algs} ? @{$opts{algs}} : @ALGS;
+	my @tests = $opts{tests} ? @{$opts{tests}} : @TESTS;
+	my @sizes = $opts{sizes} ? @{$opts{sizes}} :
+		grep { $_ <= (defined $opts{max} ? $opts{max} : 1 << 24) }
+			@SIZES;
+	my $fh = $opts{fh};
+
+	@algs = grep { Digest::SHA->new($_) } @algs;
+	print $fh map { "$_\n" } header() if $fh;
+	my @results;
+	for my $size (@sizes) {
+		my $data = "\x5a" x $size;
+		my $file;
+		if (grep { $_ eq 'addfile' } @tests) {
+			$file = tmpfile($data);
+		}
+		for my $test (@tests) {
+			next if $test eq 'addfile' && !defined $file;
+			for my $alg (@algs) {
+				my($n, $secs, $cycles) = timeit(
+					bench($test, $alg, $data, $file), $mintime);
+				my %r = (test => $test, alg => $alg,
+					bytes => $size, iters => $n,
+					secs => sprintf("%.4f", $secs),
+					ns_per_op => sprintf("%.1f",
+						$secs / $n * 1e9));
+				$r{mb_per_s} = sprintf("%.1f",
+					$n * $size / $secs / (1 << 20))
+					if $size && $secs > 0;
+				$r{cycles_per_byte} = sprintf("%.2f",
+					$cycles / ($n * $size))
+					if $size && $cycles > 0;
+				push(@results, \%r);
+				print $fh row(\%r), "\n" if $fh;
+			}
+		}
+		unlink($file) if defined $file;
+	}
+	return(@results);
+}
+
+## main: command-line entry point (used by "make bench")
+
+sub main {
+	local @ARGV = @_;
+	require Getopt::Long;
+	my($alg, $max, $mintime, $tests);
+	Getopt::Long::GetOptions(
+		'a|algorithm=i' => \$alg, 'max=s' => \$max,
+		'mintime=f' => \$mintime, 'tests=s' => \$tests,
+	) or die "usage: bench [-a alg] [--max size] [--mintime secs] " .
+		"[--tests test,...]\n";
+	die "bench: bad --max size\n"
+		if defined $max && !defined($max = size($max));
+	run(
+		fh => \*STDOUT,
+		defined $alg ? (algs => [$alg]) : (),
+		defined $max ? (max => $max) : (),
+		defined $mintime ? (mintime => $mintime) : (),
+		defined $tests ? (tests => [split(/,/, $tests)]) : (),
+	);
+	return(0);
+}
+
+1;
+__END__
+
+=head1 NAME
+
+Digest::SHA::Bench - Throughput benchmarks for Digest::SHA
+
+=head1 SYNOPSIS
+
+ make bench
+ make bench BENCH_ARGS="-a 256 --max 1G"
+ shasum --benchmark
+ shasum -a 256 --benchmark=1G
+
+ use Digest::SHA::Bench;
+
+ Digest::SHA::Bench::run(fh => \*STDOUT, algs => [256], max => 1 << 20);
+
+ my @results = Digest::SHA::Bench::run(sizes => [64, 1 << 20]);
+ printf("%s %s %s: %s MB/s\n", @{$_}{qw(test alg bytes mb_per_s)})
+ 	for @results;
+
+=head1 DESCRIPTION
+
+Digest::SHA::Bench measures how fast this build of L<Digest::SHA>
+hashes, so that builds, compilers, and releases can be compared on
+the same host.  Every algorithm is timed on messages of each size,
+through each of these paths:
+
+	oneshot		sha256($data), etc.
+	add		$sha->add($data)->digest
+	hmac		hmac_sha256($data, $key), etc.
+	addfile		$sha->addfile($file, "b")->digest
+	hex		sha256_hex($data), etc.
+	base64		sha256_base64($data), etc.
+
+The hex and base64 tests differ from oneshot only in the encoding of
+the result, so comparing them at small sizes shows what encoding
+costs.  For addfile, the message is first written to a scratch file
+in the temporary directory.
+
+Each measurement repeats the operation until it has run for at least
+I<mintime> seconds.  Cycle counts come from the x86 time-stamp counter,
+which ticks at a fixed rate that may differ from the core clock under
+frequency scaling; elsewhere they aren't reported.
+
+=head1 OUTPUT
+
+The output is tab-separated, one line per measurement, after a few
+lines starting with "#" that describe the module version, perl, the
+compiler flags perl was built with, the CPU features detected (see
+I<shadispatch>), and the cycle source.  The column header line names
+the fields:
+
+	test		oneshot, add, hmac, addfile, hex, or base64
+	alg		1, 224, 256, 384, 512, 512224, or 512256
+	bytes		message size
+	iters		number of times the operation was run
+	secs		total time
+	ns_per_op	time per operation, in nanoseconds
+	mb_per_s	throughput, in MiB per second
+	cycles_per_byte	time-stamp counter cycles per byte
+
+A field that doesn't apply (e.g. throughput for 0-byte messages) is
+"-".  The format is meant to be kept and compared across releases:
+columns may be added at the end, but won't change meaning.
+
+=head1 FUNCTIONS
+
+=over 4
+
+=item B<run(%options)>
+
+Runs the benchmarks and returns a list of hash references, one for
+each measurement, with keys named after the columns above.  Options:
+
+	algs	=> [1, 256]		# default: all algorithms
+	tests	=> ["oneshot"]		# default: all tests
+	sizes	=> [0, 1024]		# default: see max
+	max	=> 1 << 30		# largest default size (16 MiB)
+	mintime	=> 0.2			# seconds per measurement
+	fh	=> \*STDOUT		# also print results here
+
+The default sizes are 0, 16, 64, 256 bytes, 1, 4, 64 KiB, and 1, 16,
+64, 256 MiB, and 1 GiB, up to I<max>.  Large sizes need that much
+memory, and, for addfile, disk space.
+
+=item B<main(@args)>
+
+Runs the benchmarks with command-line style arguments, printing to
+standard output: I<-a> I<alg>, I<--max> I<size> (e.g. "1G"),
+I<--mintime> I<secs>, and I<--tests> I<test,...>.  This is what
+"make bench" runs, with its arguments taken from BENCH_ARGS.
+
+=item B<size($string)>
+
+Converts a size such as "4096", "64K", "16M", or "1G" to a number of
+bytes; returns I<undef> if the string isn't a size.
+
+=back
+
+=head1 SEE ALSO
+
+L<Digest::SHA>, L<shasum>
+
+=head1 AUTHOR
+
+Mark Shelor <mshelor@cpan.org>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2003-2014 Mark Shelor
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself.
+
+L<perlartistic>
+
+=cut
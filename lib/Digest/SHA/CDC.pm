@@ -0,0 +1,183 @@
+package Digest::SHA::CDC;
+
+require 5.003000;
+
+use strict;
+use warnings;
+use vars qw($VERSION);
+use Fcntl;
+
+require Digest::SHA;
+
+$VERSION = '5.94';
+
+my %FORMAT = (binary => 0, hex => 1, base64 => 2);
+
+sub new {
+	my($class, $alg, %opts) = @_;
+	$alg =~ s/\D+//g if defined $alg;
+	$alg = 1 unless defined $alg && length($alg);
+	my $format = defined $opts{format} ? $FORMAT{$opts{format}} : 0;
+	return unless defined $format;
+	return $class->_new($alg,
+		defined $opts{min} ? $opts{min} : 2048,
+		defined $opts{avg} ? $opts{avg} : 8192,
+		defined $opts{max} ? $opts{max} : 65536,
+		$format);
+}
+
+sub addfile {
+	my($self, $file) = @_;
+
+	local *FH;
+	if (ref(\$file) ne 'SCALAR') {
+		*FH = $file;
+	}
+	else {
+		$file eq '-' and open(FH, '< -')
+			or sysopen(FH, $file, O_RDONLY)
+				or Digest::SHA::_bail('Open failed');
+		binmode(FH);
+	}
+
+	my($n, $buf, @chunks) = (0, "");
+	while (($n = read(FH, $buf, 1 << 20))) {
+		push(@chunks, $self->add($buf));
+	}
+	Digest::SHA::_bail("Read failed") unless defined $n;
+	close(FH) if ref(\$file) eq 'SCALAR';
+
+	return(@chunks);
+}
+
+1;
+__END__
+
+=head1 NAME
+
+Digest::SHA::CDC - Content-defined chunking with SHA digests
+
+=head1 SYNOPSIS
+
+ use Digest::SHA::CDC;
+
+ my $cdc = Digest::SHA::CDC->new(256, min => 2048, avg => 8192,
+ 	max => 65536);
+
+ while (read($fh, my $buf, 1 << 20)) {
+ 	for my $chunk ($cdc->add($buf)) {
+ 		my($offset, $length, $digest) = @$chunk;
+ 		store($digest, $offset, $length) unless seen($digest);
+ 	}
+ }
+ for my $chunk ($cdc->finish) { ... }
+
+ @chunks = ($cdc->addfile($filename), $cdc->finish);
+
+=head1 DESCRIPTION
+
+Deduplicating storage splits data into chunks whose boundaries depend
+on the content, so that an insertion or deletion only changes the
+chunks around it, and identifies each chunk by its digest.
+
+A Digest::SHA::CDC object does both in one pass, in C: a FastCDC-style
+gear hash finds the boundaries while the same bytes are fed to the
+SHA digest of the current chunk.  Data is added incrementally, like
+the I<add> method of L<Digest::SHA>, and every chunk that's completed
+is returned as a reference to a list
+
+	[$offset, $length, $digest]
+
+where I<$offset> is the position of the chunk in the stream.  The
+chunks of a stream are contiguous, and the same bytes give the same
+chunks no matter how they're split between calls.
+
+=head1 CHUNK BOUNDARIES
+
+The boundaries are part of the format, and won't change between
+versions.  For each byte I<b>, the gear hash is updated as
+
+	fp = (fp << 1) + gear[b]	(mod 2**32)
+
+where gear[b] is the first 32 bits, read as a big-endian number, of
+the SHA-256 digest of the single byte I<b>.  The first I<min> bytes of
+a chunk aren't examined, and I<fp> starts at 0 after them.  A chunk
+ends after the first byte that leaves zero in the masked bits of
+I<fp>: up to I<avg> bytes, the mask has the top log2(I<avg>) + 2 bits
+set, and from then on the top log2(I<avg>) - 2 bits.  A chunk that
+reaches I<max> bytes ends there.
+
+=head1 METHODS
+
+=over 4
+
+=item B<new($alg, %options)>
+
+Returns a new chunker whose chunk digests use algorithm I<$alg> (1,
+224, 256, 384, 512, 512224, or 512256; strings like "sha256" also
+work), or I<undef> if an argument isn't supported.  The options are:
+
+	min	=> $bytes	# default 2048; at least 64
+	avg	=> $bytes	# default 8192; power of two, >= 256
+	max	=> $bytes	# default 65536; at most 64 MiB
+	format	=> "binary"	# or "hex" or "base64"
+
+I<min> must be less than I<avg>, which must be less than I<max>.
+
+=item B<add($data, ...)>
+
+Appends the arguments to the stream, and returns the chunks that they
+complete, in order (possibly none).
+
+=item B<addfile($filename)>
+
+=item B<addfile(*FILE)>
+
+Appends the contents of a file, read as raw bytes, and returns the
+chunks that it completes.
+
+=item B<finish>
+
+Ends the stream, and returns its last chunk unless the stream ended
+on a boundary.  The object then starts a new stream at offset 0.
+
+=item B<reset>
+
+Discards the current stream without returning its last chunk.
+
+=item B<algorithm>
+
+=item B<hashsize>
+
+=item B<min_size>
+
+=item B<avg_size>
+
+=item B<max_size>
+
+Return the object's SHA algorithm, the number of bits in a chunk
+digest, and its chunk size limits.
+
+=back
+
+=head1 SEE ALSO
+
+L<Digest::SHA>
+
+Wen Xia et al., "FastCDC: a Fast and Efficient Content-Defined Chunking
+Approach for Data Deduplication", USENIX ATC 2016.
+
+=head1 AUTHOR
+
+Mark Shelor <mshelor@cpan.org>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2003-2014 Mark Shelor
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself.
+
+L<perlartistic>
+
+=cut
@@ -0,0 +1,121 @@
+package Digest::SHA::Cache;
+
+require 5.003000;
+
+use strict;
+use warnings;
+use vars qw($VERSION);
+
+require Digest::SHA;
+
+$VERSION = '5.94';
+
+sub new {
+	my($class, $file, %opts) = @_;
+	return unless defined $file;
+	return $class->_open($file, $opts{rebuild} ? 1 : 0,
+		defined $opts{racy} ? $opts{racy} : -1);
+}
+
+sub key {
+	my($self, $file) = @_;
+	return _statkey($file);
+}
+
+1;
+__END__
+
+=head1 NAME
+
+Digest::SHA::Cache - Persistent cache of SHA file digests
+
+=head1 SYNOPSIS
+
+ use Digest::SHA qw(digest_files);
+ use Digest::SHA::Cache;
+
+ my $cache = Digest::SHA::Cache->new("$ENV{HOME}/.sha-cache")
+	or die "can't open cache: $!";
+
+ $digest = Digest::SHA->new(256)->addfile($file, "b",
+	{ cache => $cache })->hexdigest;
+
+ $sums = digest_files(256, \@files, { cache => $cache, jobs => 4 });
+
+=head1 DESCRIPTION
+
+A Digest::SHA::Cache object remembers the SHA state reached by reading
+a file, so that the file doesn't have to be read again as long as it
+stays unchanged.  Files are identified by device and inode number, and
+a cached state is used only if the file's size, modification time,
+and change time (to the nanosecond, where the system provides it) are
+the same as when the state was saved.  The algorithm and I<addfile>
+mode are part of the key, so the same file can be cached several ways.
+
+The cache is a single file holding a hash table, which is mapped into
+memory and grows as needed.  Several processes (and threads) may share
+one cache file: every lookup and update takes an I<fcntl> lock on it.
+
+A file that was modified within the last couple of seconds isn't
+cached, since a further change in the same clock tick wouldn't show
+up in its timestamps (see the I<racy> option).  Entries for files
+that no longer exist are never removed; use the I<rebuild> option to
+start over.
+
+=head1 METHODS
+
+=over 4
+
+=item B<new($filename [, %options])>
+
+Opens the cache stored in I<$filename>, creating it if necessary.  With
+the I<rebuild> option, all existing entries are discarded.  The I<racy>
+option sets how many seconds a file must go unchanged before it's
+cached (default 2); 0 is only safe for files known not to change again.
+Returns I<undef> (with I<$!> set) if the file can't be opened, if it
+isn't an empty file or a cache file, or if caching isn't supported on
+this platform.
+
+=item B<key($filename)>
+
+=item B<key(*FILE)>
+
+Returns the identity of a regular file as a packed string, suitable
+for use with I<get> and I<put>, or I<undef> if the file can't be
+examined or isn't a regular file.
+
+=item B<get($key, $alg, $mode)>
+
+Returns the packed state (see L<Digest::SHA/"getstate">) stored for
+I<$key>, algorithm I<$alg>, and I<addfile> mode I<$mode>, or I<undef>
+if there's no current entry.
+
+=item B<put($key, $alg, $mode, $state)>
+
+Stores the packed state I<$state>.  Returns false if the file is too
+recently modified to be cached, or the cache couldn't be updated.
+
+=back
+
+The I<get> and I<put> methods are the building blocks used by the
+I<cache> option of L<Digest::SHA>'s I<addfile> and I<digest_files>;
+most programs only need to pass the cache object to those.
+
+=head1 SEE ALSO
+
+L<Digest::SHA>, L<shasum>
+
+=head1 AUTHOR
+
+Mark Shelor <mshelor@cpan.org>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2003-2014 Mark Shelor
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself.
+
+L<perlartistic>
+
+=cut
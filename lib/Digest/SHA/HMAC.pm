@@ -0,0 +1,101 @@
+package Digest::SHA::HMAC;
+
+require 5.003000;
+
+use strict;
+use warnings;
+use vars qw($VERSION);
+
+require Digest::SHA;
+
+$VERSION = '5.94';
+
+sub new {
+	my($class, $alg, $key) = @_;
+	$alg =~ s/\D+//g if defined $alg;
+	$alg = 1 unless defined $alg && length($alg);
+	$key = "" unless defined $key;
+	return $class->_new($alg, $key);
+}
+
+1;
+__END__
+
+=head1 NAME
+
+Digest::SHA::HMAC - Reusable HMAC-SHA keys
+
+=head1 SYNOPSIS
+
+ use Digest::SHA::HMAC;
+
+ my $hmac = Digest::SHA::HMAC->new(256, $key);
+
+ $mac = $hmac->mac($data);
+ $mac = $hmac->mac_hex($data);
+ $mac = $hmac->mac_base64($data);
+
+ $mac = $hmac->mac_hex($method, $path, $timestamp);
+
+=head1 DESCRIPTION
+
+Computing an HMAC starts by hashing one block derived from the key for
+the inner hash, and another for the outer hash.  The I<hmac_sha*>
+functions of L<Digest::SHA> repeat that work on every call, which
+dominates the cost when the messages are short.
+
+A Digest::SHA::HMAC object does it once, when the key is given, and
+keeps the resulting inner and outer states.  Each MAC then starts from
+copies of those states, so only the message itself (plus the final
+outer block) needs hashing.  The results are identical to those of
+the corresponding I<hmac_sha*> functions.
+
+=head1 METHODS
+
+=over 4
+
+=item B<new($alg, $key)>
+
+Returns a new object for algorithm I<$alg> (1, 224, 256, 384, 512,
+512224, or 512256; strings like "sha256" also work) and key I<$key>,
+or I<undef> if the algorithm isn't supported.
+
+=item B<mac($data, ...)>
+
+=item B<mac_hex($data, ...)>
+
+=item B<mac_base64($data, ...)>
+
+Logically joins the arguments into a single string, and returns its
+HMAC under the object's key, encoded as a binary, hexadecimal, or
+Base64 string.  As with L<Digest::SHA>, the Base64 form is unpadded.
+The object isn't changed, so it can be used for any number of MACs.
+
+=item B<algorithm>
+
+Returns the SHA algorithm of the object.
+
+=item B<hashsize>
+
+Returns the number of bits in a MAC.
+
+=back
+
+=head1 SEE ALSO
+
+L<Digest::SHA>
+
+=head1 AUTHOR
+
+Mark Shelor <mshelor@cpan.org>
+
+=head1 COPYRIGHT AND LICENSE
+
+Copyright (C) 2003-2014 Mark Shelor
+
+This library is free software; you can redistribute it and/or modify
+it under the same terms as Perl itself.
+
+L<perlartistic>
+
+=cut
@@ -5,7 +5,7 @@
  *
  * Copyright (C) 2003-2014 Mark Shelor, All Rights Reserved
  *
- * Version: 5.93
+ * Version: 5.94
  * Sun Oct 26 06:00:48 MST 2014
  *
  */
@@ -88,7 +88,7 @@ static void sha1(SHA *s, UCHR *block)		/* SHA-1 transform */
 	W32 a, b, c, d, e;
 	W32 W[16];
 	W32 *wp = W;
-	W32 *H = s->H32;
+	W32 *H = s->H.H32;
 
 	SHA32_SCHED(W, block);
 
@@ -156,7 +156,7 @@ static void sha256(SHA *s, UCHR *block)		/* SHA-224/256 transform */
 	W32 W[16];
 	W32 *kp = K256;
 	W32 *wp = W;
-	W32 *H = s->H32;
+	W32 *H = s->H.H32;
 
 	SHA32_SCHED(W, block);
 
@@ -212,7 +212,129 @@ static void sha256(SHA *s, UCHR *block)		/* SHA-224/256 transform */
 	H[4] += e; H[5] += f; H[6] += g; H[7] += h;
 }
 
+/*
+ * SHA_STAT: adds n to a counter of state s and to the process-wide
+ * total; the totals are shared by the worker threads, so they're
+ * updated atomically where the compiler allows.  Without SHA_STATS
+ * the counters don't exist and SHA_STAT expands to nothing.
+ */
+
+#if defined(SHA_STATS)
+
+static SHASTATS shastats;		/* process-wide totals */
+
+#if defined(__clang__) || (defined(__GNUC__) && \
+	(__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+	#define SHA_STATADD(c, n)	\
+		__atomic_fetch_add(&(c), (SHA64) (n), __ATOMIC_RELAXED)
+#else
+	#define SHA_STATADD(c, n)	((c) += (SHA64) (n))
+#endif
+
+#define SHA_STAT(s, field, n)	\
+	(SHA_STATADD(shastats.field, n), (s)->stats.field += (SHA64) (n))
+
+#else
+
+#define SHA_STAT(s, field, n)	((void) 0)
+
+#endif
+
+/*
+ * SHA_UPDATE: defines a routine that updates state with whole bytes for
+ * one particular transform.  The block size and the transform are fixed
+ * at compile time, so the transform is called directly (and can be
+ * inlined) in the loop over whole blocks, and the only indirect call is
+ * the one through s->update for each write.
+ */
+
+#define SHA_PORTABLE		/* no target attributes */
+
+#define SHA_UPDATE(target, name, transform, blockbytes)			\
+static void target name(SHA *s, UCHR *data, ULNG nbytes)		\
+{									\
+	UINT off = s->blockcnt >> 3;					\
+									\
+	if (off > 0) {							\
+		SHA_STAT(s, partial, 1);				\
+		if (nbytes < (blockbytes) - off) {			\
+			SHA_STAT(s, bytes, nbytes);			\
+			Copy(data, s->block + off, nbytes, UCHR);	\
+			s->blockcnt += (UINT) nbytes << 3;		\
+			return;						\
+		}							\
+		SHA_STAT(s, bytes, (blockbytes) - off);			\
+		SHA_STAT(s, blocks, 1);					\
+		Copy(data, s->block + off, (blockbytes) - off, UCHR);	\
+		transform(s, s->block);					\
+		data += (blockbytes) - off;				\
+		nbytes -= (blockbytes) - off;				\
+	}								\
+	SHA_STAT(s, blocks, nbytes / (blockbytes));			\
+	SHA_STAT(s, direct, nbytes - nbytes % (blockbytes));		\
+	for (; nbytes >= (blockbytes); nbytes -= (blockbytes)) {	\
+		transform(s, data);					\
+		data += (blockbytes);					\
+	}								\
+	if (nbytes > 0) {						\
+		SHA_STAT(s, partial, 1);				\
+		SHA_STAT(s, bytes, nbytes);				\
+	}								\
+	Copy(data, s->block, nbytes, UCHR);				\
+	s->blockcnt = (UINT) nbytes << 3;				\
+}
+
+SHA_UPDATE(SHA_PORTABLE, sha1up, sha1, 64)
+SHA_UPDATE(SHA_PORTABLE, sha256up, sha256, 64)
+
 #include "sha64bit.c"
+#include "shax86.c"
+
+static void (*shaxf1)(SHA *, UCHR *) = sha1;		/* active transforms */
+static void (*shaxf256)(SHA *, UCHR *) = sha256;
+static void (*shaxf512)(SHA *, UCHR *) = sha512;
+static void (*shaup1)(SHA *, UCHR *, ULNG) = sha1up;	/* and updates */
+static void (*shaup256)(SHA *, UCHR *, ULNG) = sha256up;
+static void (*shaup512)(SHA *, UCHR *, ULNG) = sha512up;
+static int shalanes = 0;				/* multi-buffer lanes */
+static UINT (*shaxhex)(UCHR *, UINT, char *) = NULL;	/* vector encoders */
+static UINT (*shaxb64)(UCHR *, UINT, char *, int) = NULL;
+
+/* shadispatch: selects transforms for CPU features (limited by mask) */
+static int shadispatch(int mask)
+{
+	int features = shacpuid() & mask;
+
+	shaxf1 = sha1;
+	shaxf256 = sha256;
+	shaxf512 = sha512;
+	shaup1 = sha1up;
+	shaup256 = sha256up;
+	shaup512 = sha512up;
+	shalanes = 0;
+	shaxhex = NULL;
+	shaxb64 = NULL;
+#ifdef SHA_X86
+	if (features & SHA_CPU_SSSE3) {
+		shaxhex = hexssse3;
+		shaxb64 = b64ssse3;
+	}
+	if ((features & SHA_CPU_SHA) && (features & SHA_CPU_SSSE3) &&
+		(features & SHA_CPU_SSE41)) {
+		shaxf1 = sha1ni;
+		shaxf256 = sha256ni;
+		shaup1 = sha1niup;
+		shaup256 = sha256niup;
+	}
+	else if (features & SHA_CPU_AVX2)
+		shalanes = 8;
+	if ((features & SHA_CPU_AVX2) && (features & SHA_CPU_BMI2)) {
+		shaxf512 = sha512avx2;
+		shaup512 = sha512avx2up;
+	}
+#endif
+	return(features);
+}
 
 #define SETBIT(s, pos)	s[(pos) >> 3] |= (UCHR)  (0x01 << (7 - (pos) % 8))
 #define CLRBIT(s, pos)	s[(pos) >> 3] &= (UCHR) ~(0x01 << (7 - (pos) % 8))
@@ -242,31 +364,41 @@ static W32 memw32(UCHR *mem)
 	return(w);
 }
 
-/* digcpy: writes current state to digest buffer */
-static UCHR *digcpy(SHA *s)
+/* statemem: writes current state to memory in big-endian order */
+static UCHR *statemem(SHA *s, UCHR *mem)
 {
 	int i;
-	UCHR *d = s->digest;
-	W32 *p32 = s->H32;
-	W64 *p64 = s->H64;
+	W32 *p32 = s->H.H32;
+	W64 *p64 = s->H.H64;
 
 	if (s->alg <= SHA256)
-		for (i = 0; i < 8; i++, d += 4)
-			w32mem(d, *p32++);
+		for (i = 0; i < 8; i++, mem += 4)
+			w32mem(mem, *p32++);
 	else
-		for (i = 0; i < 8; i++, d += 8) {
-			w32mem(d, (W32) ((*p64 >> 16) >> 16));
-			w32mem(d+4, (W32) (*p64++ & SHA32_MAX));
+		for (i = 0; i < 8; i++, mem += 8) {
+			w32mem(mem, (W32) ((*p64 >> 16) >> 16));
+			w32mem(mem+4, (W32) (*p64++ & SHA32_MAX));
 		}
-	return(s->digest);
+	return(mem);
+}
+
+/*
+ * digcpy: writes digest of a finished state into its (now unneeded)
+ * block buffer, and returns a pointer to it; valid until the state
+ * is reused
+ */
+static UCHR *digcpy(SHA *s)
+{
+	statemem(s, s->block);
+	return(s->block);
 }
 
-/* statecpy: writes buffer to current state (opposite of digcpy) */
+/* statecpy: writes buffer to current state (opposite of statemem) */
 static UCHR *statecpy(SHA *s, UCHR *buf)
 {
 	int i;
-	W32 *p32 = s->H32;
-	W64 *p64 = s->H64;
+	W32 *p32 = s->H.H32;
+	W64 *p64 = s->H.H64;
 
 	if (s->alg <= SHA256)
 		for (i = 0; i < 8; i++, buf += 4)
@@ -278,21 +410,63 @@ static UCHR *statecpy(SHA *s, UCHR *buf)
 	return(buf);
 }
 
+/* shapack: packs state into portable form (see _getstate); returns length */
+static UINT shapack(SHA *s, UCHR *buf)
+{
+	UCHR *ptr = buf;
+
+	ptr = statemem(s, ptr);
+	Copy(s->block, ptr, s->alg <= SHA256 ? 64 : 128, UCHR);
+	ptr += s->alg <= SHA256 ? 64 : 128;
+	ptr = w32mem(ptr, s->blockcnt);
+	ptr = w32mem(ptr, s->lenhh);
+	ptr = w32mem(ptr, s->lenhl);
+	ptr = w32mem(ptr, s->lenlh);
+	ptr = w32mem(ptr, s->lenll);
+	return((UINT) (ptr - buf));
+}
+
+/* shaunpack: restores state packed by shapack (0 = invalid) */
+static int shaunpack(SHA *s, UCHR *buf, UINT len)
+{
+	UINT bc;
+
+	if (len != (s->alg <= SHA256 ? 116U : 212U))
+		return(0);
+	bc = memw32(buf + len - 20);
+	if (bc >= (s->alg <= SHA256 ? 512U : 1024U))
+		return(0);
+	buf = statecpy(s, buf);
+	Copy(buf, s->block, s->blocksize >> 3, UCHR);
+	buf += (s->blocksize >> 3);
+	s->blockcnt = bc, buf += 4;
+	s->lenhh = memw32(buf), buf += 4;
+	s->lenhl = memw32(buf), buf += 4;
+	s->lenlh = memw32(buf), buf += 4;
+	s->lenll = memw32(buf);
+	return(1);
+}
+
 #define SHA_INIT(s, algo, transform) 					\
 	do {								\
 		Zero(s, 1, SHA);					\
-		s->alg = algo; s->sha = sha ## transform;		\
+		s->alg = algo; s->sha = shaxf ## transform;		\
+		s->update = shaup ## transform;				\
 		if (s->alg <= SHA256)					\
-			Copy(H0 ## algo, s->H32, 8, SHA32);		\
+			Copy(H0 ## algo, s->H.H32, 8, W32);		\
 		else							\
-			Copy(H0 ## algo, s->H64, 8, SHA64);		\
+			Copy(H0 ## algo, s->H.H64, 8, W64);		\
 		s->blocksize = SHA ## algo ## _BLOCK_BITS;		\
 		s->digestlen = SHA ## algo ## _DIGEST_BITS >> 3;	\
 	} while (0)
 
-/* sharewind: resets digest object */
+/* sharewind: resets digest object (its counters are kept) */
 static void sharewind(SHA *s)
 {
+#if defined(SHA_STATS)
+	SHASTATS stats = s->stats;
+#endif
+
 	if      (s->alg == SHA1)   SHA_INIT(s, 1, 1);
 	else if (s->alg == SHA224) SHA_INIT(s, 224, 256);
 	else if (s->alg == SHA256) SHA_INIT(s, 256, 256);
@@ -300,6 +474,9 @@ static void sharewind(SHA *s)
 	else if (s->alg == SHA512) SHA_INIT(s, 512, 512);
 	else if (s->alg == SHA512224) SHA_INIT(s, 512224, 512);
 	else if (s->alg == SHA512256) SHA_INIT(s, 512256, 512);
+#if defined(SHA_STATS)
+	s->stats = stats;
+#endif
 }
 
 /* shainit: initializes digest object */
@@ -312,85 +489,182 @@ static int shainit(SHA *s, int alg)
 		alg != SHA512224 && alg != SHA512256)
 		return 0;
 	s->alg = alg;
+#if defined(SHA_STATS)
+	Zero(&s->stats, 1, SHASTATS);
+#endif
 	sharewind(s);
 	return 1;
 }
 
-/* shadirect: updates state directly (w/o going through s->block) */
-static ULNG shadirect(UCHR *bitstr, ULNG bitcnt, SHA *s)
+/*
+ * shaalloc: returns a zeroed state whose block starts on a cache line,
+ * or NULL; the address of the underlying allocation is kept in the
+ * bytes just before the state, for shafree
+ */
+static SHA *shaalloc(void)
 {
-	ULNG savecnt = bitcnt;
+	char *p, *q;
 
-	while (bitcnt >= s->blocksize) {
-		s->sha(s, bitstr);
-		bitstr += (s->blocksize >> 3);
-		bitcnt -= s->blocksize;
-	}
-	if (bitcnt > 0) {
-		Copy(bitstr, s->block, NBYTES(bitcnt), char);
-		s->blockcnt = bitcnt;
-	}
-	return(savecnt);
+	Newxz(p, sizeof(SHA) + SHA_ALIGN + sizeof(char *), char);
+	if (p == NULL)
+		return(NULL);
+	q = p + sizeof(char *);
+	q += (SHA_ALIGN - PTR2nat(q) % SHA_ALIGN) % SHA_ALIGN;
+	Copy(&p, q - sizeof(char *), 1, char *);
+	return((SHA *) q);
+}
+
+/* shafree: releases a state returned by shaalloc */
+static void shafree(SHA *s)
+{
+	char *p;
+
+	if (s == NULL)
+		return;
+	Copy((char *) s - sizeof(char *), &p, 1, char *);
+	Safefree(p);
 }
 
-/* shabytes: updates state for byte-aligned data in s->block */
+/* shabytes: updates state for data starting on a byte boundary */
 static ULNG shabytes(UCHR *bitstr, ULNG bitcnt, SHA *s)
 {
-	UINT offset;
-	UINT nbits;
-	ULNG savecnt = bitcnt;
+	ULNG nbytes = bitcnt >> 3;
 
-	offset = s->blockcnt >> 3;
-	if (s->blockcnt + bitcnt >= s->blocksize) {
-		nbits = s->blocksize - s->blockcnt;
-		Copy(bitstr, s->block+offset, nbits>>3, char);
-		bitcnt -= nbits;
-		bitstr += (nbits >> 3);
-		s->sha(s, s->block), s->blockcnt = 0;
-		shadirect(bitstr, bitcnt, s);
+	s->update(s, bitstr, nbytes);
+	if (bitcnt & 7) {
+		s->block[s->blockcnt >> 3] = bitstr[nbytes];
+		s->blockcnt += (UINT) (bitcnt & 7);
 	}
-	else {
-		Copy(bitstr, s->block+offset, NBYTES(bitcnt), char);
-		s->blockcnt += bitcnt;
+	return(bitcnt);
+}
+
+	/* bitcpy shifts a word at a time, loading and storing
+	 * each word in big-endian order; SHA64 can't be used to
+	 * decide the width, since sha.h falls back to SHA32 when
+	 * there's no 64-bit type */
+
+#if defined(SHA_384_512)
+	#define SHIFTW		SHA64
+	#define SHIFTW_BYTES	8
+#else
+	#define SHIFTW		SHA32
+	#define SHIFTW_BYTES	4
+#endif
+
+#if defined(BYTEORDER) && (BYTEORDER & 0xffff) == 0x4321
+	#define SHIFTW_SWAP(w)	(w)
+#elif defined(BYTEORDER) && ((BYTEORDER & 0xffff) == 0x1234 || \
+	(BYTEORDER & 0xffff) == 0x5678) && \
+	(defined(__clang__) || (defined(__GNUC__) && \
+	(__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 3))))
+	#if SHIFTW_BYTES == 8
+		#define SHIFTW_SWAP(w)	__builtin_bswap64(w)
+	#else
+		#define SHIFTW_SWAP(w)	__builtin_bswap32(w)
+	#endif
+#endif
+
+	/* Fails to compile if SHIFTW is too narrow for SHIFTW_BYTES
+	 * (or, when swapped in place, isn't exactly that wide) */
+
+#if defined(SHIFTW_SWAP)
+	#define SHIFTW_FITS	(sizeof(SHIFTW) == SHIFTW_BYTES)
+#else
+	#define SHIFTW_FITS	(sizeof(SHIFTW) >= SHIFTW_BYTES)
+#endif
+
+typedef char shiftwfits[SHIFTW_FITS ? 1 : -1];
+
+/* memshiftw: returns word from memory written in big-endian order */
+static SHIFTW memshiftw(UCHR *mem)
+{
+	SHIFTW w;
+#if defined(SHIFTW_SWAP)
+	Copy(mem, &w, 1, SHIFTW);
+	return(SHIFTW_SWAP(w));
+#else
+	int i;
+
+	for (w = 0, i = 0; i < SHIFTW_BYTES; i++)
+		w = (w << 8) | mem[i];
+	return(w);
+#endif
+}
+
+/* shiftwmem: writes word to memory in big-endian order */
+static void shiftwmem(UCHR *mem, SHIFTW w)
+{
+#if defined(SHIFTW_SWAP)
+	w = SHIFTW_SWAP(w);
+	Copy(&w, mem, 1, SHIFTW);
+#else
+	int i;
+
+	for (i = SHIFTW_BYTES - 1; i >= 0; i--, w >>= 8)
+		mem[i] = (UCHR) w;
+#endif
+}
+
+/*
+ * bitcpy: stores n bytes of src, shifted left by gap bits, into dst;
+ * src[n] supplies the low bits of the last byte if more is set, and
+ * isn't read otherwise
+ */
+static void bitcpy(UCHR *dst, UCHR *src, UINT n, UINT gap, int more)
+{
+	UINT i;
+	UINT lim = more ? n : n - 1;
+	SHIFTW w;
+
+	for (i = 0; i + SHIFTW_BYTES <= lim; i += SHIFTW_BYTES) {
+		w = memshiftw(src+i) << gap |
+			(SHIFTW) (src[i+SHIFTW_BYTES] >> (8 - gap));
+		shiftwmem(dst+i, w);
 	}
-	return(savecnt);
+	for (; i < lim; i++)
+		dst[i] = (UCHR) (src[i] << gap) | (UCHR) (src[i+1] >> (8 - gap));
+	if (!more)
+		dst[n-1] = (UCHR) (src[n-1] << gap);
 }
 
 /* shabits: updates state for bit-aligned data in s->block */
 static ULNG shabits(UCHR *bitstr, ULNG bitcnt, SHA *s)
 {
-	UINT i;
-	UINT gap;
+	UINT gap, n;
 	ULNG nbits;
-	UCHR buf[1<<9];
-	UINT bufsize = sizeof(buf);
-	ULNG bufbits = (ULNG) bufsize << 3;
-	UINT nbytes = NBYTES(bitcnt);
+	ULNG nbytes = NBYTES(bitcnt);
 	ULNG savecnt = bitcnt;
 
+	SHA_STAT(s, bits, nbytes);
 	gap = 8 - s->blockcnt % 8;
 	s->block[s->blockcnt>>3] &= (UCHR) (~0 << gap);
 	s->block[s->blockcnt>>3] |= (UCHR) (*bitstr >> (8 - gap));
 	s->blockcnt += bitcnt < gap ? bitcnt : gap;
 	if (bitcnt < gap)
 		return(savecnt);
-	if (s->blockcnt == s->blocksize)
+	if (s->blockcnt == s->blocksize) {
+		SHA_STAT(s, blocks, 1);
 		s->sha(s, s->block), s->blockcnt = 0;
+	}
 	if ((bitcnt -= gap) == 0)
 		return(savecnt);
-	while (nbytes > bufsize) {
-		for (i = 0; i < bufsize; i++)
-			buf[i] = (UCHR) (bitstr[i] << gap) |
-				 (UCHR) (bitstr[i+1] >> (8-gap));
-		nbits = bitcnt < bufbits ? bitcnt : bufbits;
-		shabytes(buf, nbits, s);
-		bitcnt -= nbits, bitstr += bufsize, nbytes -= bufsize;
+	while (bitcnt > 0) {
+		n = (s->blocksize - s->blockcnt) >> 3;
+		if (n > NBYTES(bitcnt))
+			n = (UINT) NBYTES(bitcnt);
+		SHA_STAT(s, partial, 1);
+		bitcpy(s->block + (s->blockcnt >> 3), bitstr, n, gap,
+			n < nbytes);
+		nbits = (ULNG) n << 3;
+		if (nbits > bitcnt)
+			nbits = bitcnt;
+		s->blockcnt += (UINT) nbits;
+		if (s->blockcnt == s->blocksize) {
+			SHA_STAT(s, blocks, 1);
+			s->sha(s, s->block), s->blockcnt = 0;
+		}
+		bitcnt -= nbits, bitstr += n, nbytes -= n;
 	}
-	for (i = 0; i < nbytes - 1; i++)
-		buf[i] = (UCHR) (bitstr[i] << gap) |
-			 (UCHR) (bitstr[i+1] >> (8-gap));
-	buf[nbytes-1] = (UCHR) (bitstr[nbytes-1] << gap);
-	shabytes(buf, bitcnt, s);
 	return(savecnt);
 }
 
@@ -403,36 +677,81 @@ static ULNG shawrite(UCHR *bitstr, ULNG bitcnt, SHA *s)
 		if (SHA_LO32(++s->lenlh) == 0)
 			if (SHA_LO32(++s->lenhl) == 0)
 				s->lenhh++;
-	if (s->blockcnt == 0)
-		return(shadirect(bitstr, bitcnt, s));
-	else if (s->blockcnt % 8 == 0)
+	if (s->blockcnt % 8 == 0)
 		return(shabytes(bitstr, bitcnt, s));
 	else
 		return(shabits(bitstr, bitcnt, s));
 }
 
+#ifndef SHA_BITS_CHUNK
+#define SHA_BITS_CHUNK	((size_t) 1 << 28)	/* bit count fits a ULNG */
+#endif
+
+/*
+ * shawritebytes: updates state with nbytes of data, adding the whole
+ * length to the message bit count in a single step; unlike shawrite,
+ * the length may be any size_t (it's passed on in chunks that fit a
+ * ULNG, which is only 32 bits on LLP64 systems such as Win64)
+ */
+static void shawritebytes(UCHR *data, size_t nbytes, SHA *s)
+{
+	W32 lo, mid, hi;
+	size_t n;
+
+	if (nbytes < 1)
+		return;
+	lo  = SHA_LO32((W32) nbytes << 3);
+	mid = SHA_LO32((W32) (nbytes >> 29));
+	hi  = (W32) (((nbytes >> 29) >> 16) >> 16);
+	if (SHA_LO32(s->lenll += lo) < lo)
+		if (SHA_LO32(++s->lenlh) == 0)
+			if (SHA_LO32(++s->lenhl) == 0)
+				s->lenhh++;
+	if (SHA_LO32(s->lenlh += mid) < mid)
+		if (SHA_LO32(++s->lenhl) == 0)
+			s->lenhh++;
+	if (hi && SHA_LO32(s->lenhl += hi) < hi)
+		s->lenhh++;
+	for (; nbytes > 0; data += n, nbytes -= n) {
+		n = nbytes > SHA_BITS_CHUNK ? SHA_BITS_CHUNK : nbytes;
+		if (s->blockcnt % 8 == 0)
+			s->update(s, data, (ULNG) n);
+		else
+			shabits(data, (ULNG) n << 3, s);
+	}
+}
+
 /* shafinish: pads remaining block(s) and computes final digest state */
 static void shafinish(SHA *s)
 {
-	UINT lenpos, lhpos, llpos;
+	UINT lenpos, lhpos, llpos, nbytes;
 
-	lenpos = s->blocksize == SHA1_BLOCK_BITS ? 448 : 896;
+	lenpos = s->blocksize == SHA1_BLOCK_BITS ?  56 : 112;
 	lhpos  = s->blocksize == SHA1_BLOCK_BITS ?  56 : 120;
 	llpos  = s->blocksize == SHA1_BLOCK_BITS ?  60 : 124;
-	SETBIT(s->block, s->blockcnt), s->blockcnt++;
-	while (s->blockcnt > lenpos)
-		if (s->blockcnt < s->blocksize)
+	nbytes = s->blocksize >> 3;
+	SHA_STAT(s, finish, 1);
+	if (s->blockcnt % 8 == 0)
+		s->block[s->blockcnt >> 3] = 0x80, s->blockcnt += 8;
+	else {
+		SETBIT(s->block, s->blockcnt), s->blockcnt++;
+		while (s->blockcnt % 8)
 			CLRBIT(s->block, s->blockcnt), s->blockcnt++;
-		else
-			s->sha(s, s->block), s->blockcnt = 0;
-	while (s->blockcnt < lenpos)
-		CLRBIT(s->block, s->blockcnt), s->blockcnt++;
+	}
+	if ((s->blockcnt >> 3) > lenpos) {
+		Zero(s->block + (s->blockcnt >> 3),
+			nbytes - (s->blockcnt >> 3), UCHR);
+		SHA_STAT(s, blocks, 1);
+		s->sha(s, s->block), s->blockcnt = 0;
+	}
+	Zero(s->block + (s->blockcnt >> 3), lenpos - (s->blockcnt >> 3), UCHR);
 	if (s->blocksize > SHA1_BLOCK_BITS) {
 		w32mem(s->block + 112, s->lenhh);
 		w32mem(s->block + 116, s->lenhl);
 	}
 	w32mem(s->block + lhpos, s->lenlh);
 	w32mem(s->block + llpos, s->lenll);
+	SHA_STAT(s, blocks, 1);
 	s->sha(s, s->block);
 }
 
@@ -442,63 +761,59 @@ static void shafinish(SHA *s)
 static char xmap[] =
 	"0123456789abcdef";
 
-/* shahex: returns pointer to current digest (hexadecimal) */
-static char *shahex(SHA *s)
+/* hexenc: writes n bytes of in as hex to out; returns output length */
+static size_t hexenc(UCHR *in, UINT n, char *out)
 {
-	UINT i;
-	char *h;
-	UCHR *d;
-
-	d = digcpy(s);
-	s->hex[0] = '\0';
-	if (HEXLEN((size_t) s->digestlen) >= sizeof(s->hex))
-		return(s->hex);
-	for (i = 0, h = s->hex; i < s->digestlen; i++) {
-		*h++ = xmap[(*d >> 4) & 0x0f];
-		*h++ = xmap[(*d++   ) & 0x0f];
+	UINT i = shaxhex ? shaxhex(in, n, out) : 0;
+	char *h = out + HEXLEN(i);
+
+	for (; i < n; i++) {
+		*h++ = xmap[(in[i] >> 4) & 0x0f];
+		*h++ = xmap[(in[i]     ) & 0x0f];
 	}
 	*h = '\0';
-	return(s->hex);
+	return((size_t) (h - out));
 }
 
 /* bmap: translation map for Base 64 encoding */
 static char bmap[] =
 	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-/* encbase64: encodes input (0 to 3 bytes) into Base 64 */
-static void encbase64(UCHR *in, UINT n, char *out)
-{
-	UCHR byte[3] = {0, 0, 0};
+/* umap: translation map for URL-safe Base 64 encoding (RFC 4648) */
+static char umap[] =
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
 
-	out[0] = '\0';
-	if (n < 1 || n > 3)
-		return;
-	Copy(in, byte, n, UCHR);
-	out[0] = bmap[byte[0] >> 2];
-	out[1] = bmap[((byte[0] & 0x03) << 4) | (byte[1] >> 4)];
-	out[2] = bmap[((byte[1] & 0x0f) << 2) | (byte[2] >> 6)];
-	out[3] = bmap[byte[2] & 0x3f];
-	out[n+1] = '\0';
-}
-
-/* shabase64: returns pointer to current digest (Base 64) */
-static char *shabase64(SHA *s)
-{
-	UINT n;
-	UCHR *q;
-	char out[5];
-
-	q = digcpy(s);
-	s->base64[0] = '\0';
-	if (B64LEN((size_t) s->digestlen) >= sizeof(s->base64))
-		return(s->base64);
-	for (n = s->digestlen; n > 3; n -= 3, q += 3) {
-		encbase64(q, 3, out);
-		strcat(s->base64, out);
+/*
+ * b64enc: writes n bytes of in as Base 64 to out, using the URL-safe
+ * alphabet and '=' padding as selected by flags; returns output length
+ */
+static size_t b64enc(UCHR *in, UINT n, char *out, int flags)
+{
+	char *map = (flags & SHA_B64_URL) ? umap : bmap;
+	UINT i = shaxb64 ? shaxb64(in, n, out, flags & SHA_B64_URL) : 0;
+	char *p = out + (i / 3) * 4;
+
+	for (; n - i >= 3; i += 3, p += 4) {
+		p[0] = map[in[i] >> 2];
+		p[1] = map[((in[i] & 0x03) << 4) | (in[i+1] >> 4)];
+		p[2] = map[((in[i+1] & 0x0f) << 2) | (in[i+2] >> 6)];
+		p[3] = map[in[i+2] & 0x3f];
+	}
+	if (n - i == 1) {
+		*p++ = map[in[i] >> 2];
+		*p++ = map[(in[i] & 0x03) << 4];
+		if (flags & SHA_B64_PAD)
+			*p++ = '=', *p++ = '=';
 	}
-	encbase64(q, n, out);
-	strcat(s->base64, out);
-	return(s->base64);
+	else if (n - i == 2) {
+		*p++ = map[in[i] >> 2];
+		*p++ = map[((in[i] & 0x03) << 4) | (in[i+1] >> 4)];
+		*p++ = map[(in[i+1] & 0x0f) << 2];
+		if (flags & SHA_B64_PAD)
+			*p++ = '=';
+	}
+	*p = '\0';
+	return((size_t) (p - out));
 }
 
 /* hmacinit: initializes HMAC-SHA digest object */
@@ -548,14 +863,126 @@ static void hmacfinish(HMAC *h)
 
 #define hmacdigest(h)	digcpy(&(h)->osha)
 
-/* hmachex: returns pointer to digest (hexadecimal) */
-static char *hmachex(HMAC *h)
+/* hmacwritebytes: updates HMAC state with nbytes of data */
+static void hmacwritebytes(UCHR *data, size_t nbytes, HMAC *h)
+{
+	shawritebytes(data, nbytes, &h->isha);
+}
+
+/* padblock: pads block holding a digest-sized message after one block */
+static void padblock(SHA *s, UCHR *block)
+{
+	UINT bs = s->blocksize >> 3;
+	ULNG bits = (ULNG) (bs + s->digestlen) << 3;
+
+	Zero(block, bs, UCHR);
+	block[s->digestlen] = 0x80;
+	w32mem(block + bs - 4, (W32) bits);
+}
+
+/*
+ * pbkdf2: derives dklen bytes from password and salt (ref. RFC 8018)
+ *
+ * After the first HMAC of each output block, every iteration hashes
+ * exactly one digest-sized message, so the padded inner and outer
+ * blocks are laid out once and each iteration is just two transforms
+ * starting from the precomputed pad states.
+ */
+static int pbkdf2(int alg, UCHR *pw, UINT pwlen, UCHR *salt, size_t saltlen,
+	ULNG iter, UCHR *out, size_t dklen)
+{
+	HMAC key, h;
+	SHA s;
+	UCHR ib[SHA_MAX_BLOCK_BITS/8], ob[SHA_MAX_BLOCK_BITS/8];
+	UCHR t[SHA_MAX_DIGEST_BITS/8], cnt[4];
+	UINT i, n, dl;
+	ULNG j;
+	W32 blk;
+
+	if (iter < 1 || hmacinit(&key, alg, pw, pwlen) == NULL)
+		return(0);
+	dl = key.digestlen;
+	Copy(&key.isha, &s, 1, SHA);
+	padblock(&s, ib);
+	padblock(&s, ob);
+	for (blk = 1; dklen > 0; blk++) {
+		Copy(&key, &h, 1, HMAC);
+		hmacwritebytes(salt, saltlen, &h);
+		w32mem(cnt, blk);
+		hmacwrite(cnt, 32, &h);
+		hmacfinish(&h);
+		Copy(hmacdigest(&h), t, dl, UCHR);
+		Copy(t, ib, dl, UCHR);
+		SHA_STAT(&s, blocks, 2 * (SHA64) (iter - 1));
+		for (j = 1; j < iter; j++) {
+			s.H = key.isha.H;
+			s.sha(&s, ib);
+			Copy(digcpy(&s), ob, dl, UCHR);
+			s.H = key.osha.H;
+			s.sha(&s, ob);
+			Copy(digcpy(&s), ib, dl, UCHR);
+			for (i = 0; i < dl; i++)
+				t[i] ^= ib[i];
+		}
+		n = dklen < dl ? (UINT) dklen : dl;
+		Copy(t, out, n, UCHR);
+		out += n;
+		dklen -= n;
+	}
+	Zero(&key, 1, HMAC);
+	Zero(&h, 1, HMAC);
+	Zero(&s, 1, SHA);
+	Zero(ib, sizeof(ib), UCHR);
+	Zero(ob, sizeof(ob), UCHR);
+	Zero(t, sizeof(t), UCHR);
+	return(1);
+}
+
+/* hkdfextract: computes pseudorandom key from salt and input key */
+static UINT hkdfextract(int alg, UCHR *salt, UINT saltlen, UCHR *ikm,
+	size_t ikmlen, UCHR *prk)
 {
-	return(shahex(&h->osha));
+	HMAC h;
+	UINT dl;
+
+	if (hmacinit(&h, alg, salt, saltlen) == NULL)
+		return(0);
+	hmacwritebytes(ikm, ikmlen, &h);
+	hmacfinish(&h);
+	Copy(hmacdigest(&h), prk, dl = h.digestlen, UCHR);
+	Zero(&h, 1, HMAC);
+	return(dl);
 }
 
-/* hmacbase64: returns pointer to digest (Base 64) */
-static char *hmacbase64(HMAC *h)
+/* hkdfexpand: expands pseudorandom key into len bytes (ref. RFC 5869) */
+static int hkdfexpand(int alg, UCHR *prk, UINT prklen, UCHR *info,
+	size_t infolen, UCHR *out, size_t len)
 {
-	return(shabase64(&h->osha));
+	HMAC key, h;
+	UCHR t[SHA_MAX_DIGEST_BITS/8];
+	UCHR c;
+	UINT n, tlen = 0;
+
+	if (hmacinit(&key, alg, prk, prklen) == NULL)
+		return(0);
+	if (len > 255 * (size_t) key.digestlen)
+		return(0);
+	for (c = 1; len > 0; c++) {
+		Copy(&key, &h, 1, HMAC);
+		hmacwrite(t, (ULNG) tlen << 3, &h);
+		hmacwritebytes(info, infolen, &h);
+		hmacwrite(&c, 8, &h);
+		hmacfinish(&h);
+		Copy(hmacdigest(&h), t, tlen = key.digestlen, UCHR);
+		n = len < tlen ? (UINT) len : tlen;
+		Copy(t, out, n, UCHR);
+		out += n;
+		len -= n;
+	}
+	Zero(&key, 1, HMAC);
+	Zero(&h, 1, HMAC);
+	Zero(t, sizeof(t), UCHR);
+	return(1);
 }
+
+#include "shamulti.c"
@@ -5,7 +5,7 @@
  *
  * Copyright (C) 2003-2014 Mark Shelor, All Rights Reserved
  *
- * Version: 5.93
+ * Version: 5.94
  * Sun Oct 26 06:00:48 MST 2014
  *
  */
@@ -77,6 +77,17 @@
 	#define SHA_384_512
 #endif
 
+	/* x86 instruction-set extensions need GCC 4.9+ (or clang)
+	 * for per-function target attributes and <cpuid.h> */
+
+#if !defined(NO_SHA_X86) && (defined(__x86_64__) || defined(__i386__))
+	#if defined(__clang__) || (defined(__GNUC__) && \
+		(__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+		#define SHA_X86
+		#define SHA_TARGET(isa)	__attribute__((target(isa)))
+	#endif
+#endif
+
 #if defined(BYTEORDER) && (BYTEORDER & 0xffff) == 0x4321
 	#if defined(SHA32_ALIGNED)
 		#define SHA32_SCHED(W, b)	Copy(b, W, 64, char)
@@ -130,24 +141,54 @@
 #define SHA_MAX_DIGEST_BITS	SHA512_DIGEST_BITS
 #define SHA_MAX_HEX_LEN		(SHA_MAX_DIGEST_BITS / 4)
 #define SHA_MAX_BASE64_LEN	(1 + (SHA_MAX_DIGEST_BITS / 6))
+#define SHA_MAX_STATE_LEN	212		/* packed by shapack */
+
+#define SHA_B64_URL		0x01		/* Base 64 encoding options */
+#define SHA_B64_PAD		0x02
 
 #if !defined(SHA64)
 	#define SHA64	SHA32
 #endif
 
+#define SHA_ALIGN		64		/* cache line (see shaalloc) */
+
+	/* Hot-path counters, compiled in only with -DSHA_STATS
+	 * (perl Makefile.PL -s); see SHA_STAT in sha.c */
+
+#if defined(SHA_STATS)
+typedef struct {
+	SHA64 blocks;		/* blocks compressed */
+	SHA64 direct;		/* bytes compressed in place */
+	SHA64 bytes;		/* bytes copied into the block buffer */
+	SHA64 bits;		/* bytes shifted in by shabits */
+	SHA64 partial;		/* copies into the block buffer */
+	SHA64 finish;		/* shafinish calls */
+	SHA64 reads;		/* reads and mapped windows */
+	SHA64 readbytes;	/* bytes read or mapped */
+} SHASTATS;
+#endif
+
+	/* The block comes first, so it starts on a cache line in
+	 * states from shaalloc, and the digest of a finished state
+	 * is written there too (see digcpy) rather than in its own
+	 * buffer.  SHA-1/224/256 use H.H32, and SHA-384/512 H.H64. */
+
 typedef struct SHA {
-	int alg;
-	void (*sha)(struct SHA *, unsigned char *);
-	SHA32 H32[8];
-	SHA64 H64[8];
 	unsigned char block[SHA_MAX_BLOCK_BITS/8];
+	union {
+		SHA32 H32[8];
+		SHA64 H64[8];
+	} H;
+	SHA32 lenhh, lenhl, lenlh, lenll;
 	unsigned int blockcnt;
 	unsigned int blocksize;
-	SHA32 lenhh, lenhl, lenlh, lenll;
-	unsigned char digest[SHA_MAX_DIGEST_BITS/8];
 	unsigned int digestlen;
-	char hex[SHA_MAX_HEX_LEN+1];
-	char base64[SHA_MAX_BASE64_LEN+1];
+	int alg;
+	void (*sha)(struct SHA *, unsigned char *);
+	void (*update)(struct SHA *, unsigned char *, unsigned long);
+#if defined(SHA_STATS)
+	SHASTATS stats;
+#endif
 } SHA;
 
 typedef struct {
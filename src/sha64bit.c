@@ -5,7 +5,7 @@
  *
  * Copyright (C) 2003-2014 Mark Shelor, All Rights Reserved
  *
- * Version: 5.93
+ * Version: 5.94
  * Sun Oct 26 06:00:48 MST 2014
  *
  */
@@ -15,6 +15,7 @@
 #undef sha_384_512
 #undef W64
 #undef sha512
+#undef sha512up
 #undef H0384
 #undef H0512
 #undef H0512224
@@ -96,7 +97,7 @@ static void sha512(SHA *s, unsigned char *block) /* SHA-384/512 transform */
 {
 	W64 a, b, c, d, e, f, g, h, T1, T2;
 	W64 W[80];
-	W64 *H = s->H64;
+	W64 *H = s->H.H64;
 	int t;
 
 	SHA64_SCHED(W, block);
@@ -114,4 +115,93 @@ static void sha512(SHA *s, unsigned char *block) /* SHA-384/512 transform */
 	H[4] += e; H[5] += f; H[6] += g; H[7] += h;
 }
 
+SHA_UPDATE(SHA_PORTABLE, sha512up, sha512, 128)
+
+#ifdef SHA_X86
+
+#include <immintrin.h>
+
+#undef sha512avx2
+#undef sha512avx2up
+
+#define V64		__m256i
+#define VADDQ(x, y)	_mm256_add_epi64(x, y)
+#define VXORQ(x, y)	_mm256_xor_si256(x, y)
+#define VROTRQ(x, n)	_mm256_or_si256(_mm256_srli_epi64(x, n), \
+				_mm256_slli_epi64(x, 64-(n)))
+#define VsigmaQ0(x)	VXORQ(VXORQ(VROTRQ(x,  1), VROTRQ(x,  8)), \
+				_mm256_srli_epi64(x, 7))
+#define VsigmaQ1(x)	VXORQ(VXORQ(VROTRQ(x, 19), VROTRQ(x, 61)), \
+				_mm256_srli_epi64(x, 6))
+
+/*
+ * SHA-384/512 transform with an AVX2 message schedule
+ *
+ * The sixteen most recent schedule words stay in four registers, and
+ * four new words are computed per step.  Since W[t+2] and W[t+3] depend
+ * on W[t] and W[t+1], the sigma1 term is added in two halves: first for
+ * the lower pair using W[t-2] and W[t-1], then for the upper pair using
+ * the freshly computed lower pair.  The round constants are folded into
+ * the schedule, leaving one addition per round.
+ */
+
+#define VWORDS(x, y)	_mm256_permute4x64_epi64(		\
+				_mm256_blend_epi32(x, y, 0x03), 0x39)
+
+static void SHA_TARGET("avx2,bmi2") sha512avx2(SHA *s, unsigned char *block)
+{
+	W64 a, b, c, d, e, f, g, h, T1;
+	W64 WK[80];
+	W64 *H = s->H.H64;
+	V64 X[4], x, y;
+	int t;
+	const V64 bswap = _mm256_set_epi8(
+		8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7,
+		8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+
+	for (t = 0; t < 4; t++) {
+		x = _mm256_loadu_si256((V64 *) (block + 32*t));
+		X[t] = _mm256_shuffle_epi8(x, bswap);
+		_mm256_storeu_si256((V64 *) (WK+4*t),
+			VADDQ(X[t], _mm256_loadu_si256((V64 *) (K512+4*t))));
+	}
+	for (t = 16; t < 80; t += 4) {
+		x = VADDQ(X[0], VsigmaQ0(VWORDS(X[0], X[1])));
+		x = VADDQ(x, VWORDS(X[2], X[3]));
+		y = _mm256_blend_epi32(_mm256_permute4x64_epi64(X[3], 0x0e),
+			_mm256_setzero_si256(), 0xf0);
+		x = VADDQ(x, VsigmaQ1(y));
+		y = _mm256_permute2x128_si256(x, x, 0x08);
+		x = VADDQ(x, VsigmaQ1(y));
+		X[0] = X[1]; X[1] = X[2]; X[2] = X[3]; X[3] = x;
+		_mm256_storeu_si256((V64 *) (WK+t),
+			VADDQ(x, _mm256_loadu_si256((V64 *) (K512+t))));
+	}
+
+/* rounds use the rotating-role technique of sha256() in sha.c */
+
+#define M5(a, b, c, d, e, f, g, h, t)				\
+	T1 = h + SIGMAQ1(e) + Ch(e, f, g) + WK[t];		\
+	h  = T1 + SIGMAQ0(a) + Ma(a, b, c); d += T1;
+
+	a = H[0]; b = H[1]; c = H[2]; d = H[3];
+	e = H[4]; f = H[5]; g = H[6]; h = H[7];
+	for (t = 0; t < 80; t += 8) {
+		M5(a, b, c, d, e, f, g, h, t  );
+		M5(h, a, b, c, d, e, f, g, t+1);
+		M5(g, h, a, b, c, d, e, f, t+2);
+		M5(f, g, h, a, b, c, d, e, t+3);
+		M5(e, f, g, h, a, b, c, d, t+4);
+		M5(d, e, f, g, h, a, b, c, t+5);
+		M5(c, d, e, f, g, h, a, b, t+6);
+		M5(b, c, d, e, f, g, h, a, t+7);
+	}
+	H[0] += a; H[1] += b; H[2] += c; H[3] += d;
+	H[4] += e; H[5] += f; H[6] += g; H[7] += h;
+}
+
+SHA_UPDATE(SHA_TARGET("avx2,bmi2"), sha512avx2up, sha512avx2, 128)
+
+#endif	/* #ifdef SHA_X86 */
+
 #endif	/* #ifdef SHA_384_512 */
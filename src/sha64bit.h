@@ -5,7 +5,7 @@
  *
  * Copyright (C) 2003-2014 Mark Shelor, All Rights Reserved
  *
- * Version: 5.93
+ * Version: 5.94
  * Sun Oct 26 06:00:48 MST 2014
  *
  * The following macros supply placeholder values that enable the
@@ -20,6 +20,9 @@
 #define sha_384_512		0
 #define W64			SHA32
 #define sha512			NULL
+#define sha512avx2		NULL
+#define sha512up		NULL
+#define sha512avx2up		NULL
 #define H0384			H01
 #define H0512			H01
 #define H0512224		H01
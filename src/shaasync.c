@@ -0,0 +1,442 @@
+/*
+ * shaasync.c: hashes files in the background on a persistent thread pool
+ *
+ * Copyright (C) 2003-2014 Mark Shelor, All Rights Reserved
+ *
+ * Jobs wait in a queue for one of at most asyncmax worker threads,
+ * which are started only when no worker is idle, and then stay around
+ * for more work.  A job hashes a file into its own copy of the caller's
+ * state, so nothing the caller owns is touched off the main thread.
+ * As in shapool.c, the workers never call into Perl.
+ *
+ * Every job belongs to an owner, one per Perl interpreter, so that
+ * interpreters sharing the pool (under ithreads) only ever see their
+ * own jobs.  A finished job is moved to its owner's done list, and a
+ * byte is written to the owner's pipe (unless one is already waiting
+ * there), so an event loop can watch the read end of the pipe and
+ * collect finished jobs with asyncreap and asynctake.  Jobs are known
+ * to the caller by serial number, never by address.  An owner whose
+ * interpreter goes away is marked dead, and freed with the last of
+ * its jobs still running.
+ *
+ * Without thread support, asyncsubmit runs the job before returning,
+ * and there's no pipe.
+ *
+ */
+
+/* SHAJOB: one file to be hashed in the background */
+typedef struct SHAJOB {
+	struct SHAJOB *next;	/* in the queue, or an owner's list */
+	struct SHAOWNER *owner;
+	ULNG id;		/* serial number within owner */
+	SHA sha;		/* copy of caller's state */
+	char *path;		/* file to open, or NULL to use fd */
+	int fd;			/* descriptor owned by the job */
+	Off_t pos;		/* where to start in fd (< 0 = current) */
+	int err;		/* errno, or 0 on success */
+} SHAJOB;
+
+/* SHAOWNER: the background jobs of one interpreter */
+typedef struct SHAOWNER {
+	struct SHAOWNER *next;
+	void *interp;		/* submitting interpreter */
+	ULNG lastid;
+	int pending;		/* jobs queued or running */
+	int dead;		/* interpreter destroyed */
+	SHAJOB *done;		/* finished jobs, newest first */
+	SHAJOB *reaped;		/* reaped but not taken, oldest first */
+	SHAJOB *reapedtail;
+	int pipe[2];
+	int signaled;		/* byte waiting in pipe */
+} SHAOWNER;
+
+static SHAOWNER *asyncowners = NULL;
+
+#ifdef SHA_THREADS
+
+static pthread_mutex_t asynclock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t asyncwork = PTHREAD_COND_INITIALIZER;
+static SHAJOB *asynchead = NULL;	/* queued jobs, oldest first */
+static SHAJOB *asynctail = NULL;
+static int asyncthreads = 0;		/* workers started */
+static int asyncidle = 0;		/* workers waiting for a job */
+static int asyncmaxthreads = 0;		/* 0 = one per processor */
+static int asynchooked = 0;
+
+#define ASYNC_LOCK()	pthread_mutex_lock(&asynclock)
+#define ASYNC_UNLOCK()	pthread_mutex_unlock(&asynclock)
+
+#else
+
+#define ASYNC_LOCK()	((void) 0)
+#define ASYNC_UNLOCK()	((void) 0)
+
+#endif	/* #ifdef SHA_THREADS */
+
+/* asyncrun: hashes the job's file into its state (on a worker) */
+static void asyncrun(SHAJOB *j)
+{
+	int fd = j->fd, n;
+
+	if (fd < 0 && (fd = open(j->path, O_RDONLY | O_BINARY)) < 0) {
+		j->err = errno;
+		return;
+	}
+	if ((n = shamapfd(&j->sha, fd, j->pos < 0 ? 0 : j->pos)) == 0) {
+		if (j->pos > 0 && lseek(fd, j->pos, SEEK_SET) < 0)
+			n = -1;
+		else
+			n = shareadfd(&j->sha, fd);
+	}
+	if (n < 0)
+		j->err = errno ? errno : EIO;
+	close(fd);
+	j->fd = -1;
+}
+
+/* asyncjob: returns a new job for owner o, or NULL */
+static SHAJOB *asyncjob(SHAOWNER *o, SHA *s, char *path, size_t len)
+{
+	SHAJOB *j;
+
+	if ((j = (SHAJOB *) calloc(1, sizeof(SHAJOB))) == NULL)
+		return(NULL);
+	j->owner = o;
+	j->fd = -1;
+	Copy(s, &j->sha, 1, SHA);
+	if (path != NULL) {
+		if ((j->path = (char *) malloc(len + 1)) == NULL) {
+			free(j);
+			return(NULL);
+		}
+		Copy(path, j->path, len, char);
+		j->path[len] = '\0';
+	}
+	return(j);
+}
+
+/* asyncfree: releases a job (may be called on a worker) */
+static void asyncfree(SHAJOB *j)
+{
+	if (j->fd >= 0)
+		close(j->fd);
+	free(j->path);
+	free(j);
+}
+
+/* asyncfreelist: releases a list of jobs */
+static void asyncfreelist(SHAJOB *j)
+{
+	SHAJOB *next;
+
+	for (; j != NULL; j = next) {
+		next = j->next;
+		asyncfree(j);
+	}
+}
+
+/* asyncunlink: removes owner o from the list of owners (lock held) */
+static void asyncunlink(SHAOWNER *o)
+{
+	SHAOWNER **p;
+
+	for (p = &asyncowners; *p != NULL; p = &(*p)->next)
+		if (*p == o) {
+			*p = o->next;
+			break;
+		}
+}
+
+/* asyncclose: closes the pipe of owner o (lock held) */
+static void asyncclose(SHAOWNER *o)
+{
+	if (o->pipe[0] >= 0) {
+		close(o->pipe[0]);
+		close(o->pipe[1]);
+		o->pipe[0] = o->pipe[1] = -1;
+	}
+	o->signaled = 0;
+}
+
+/*
+ * asyncowner: returns the owner for interpreter interp, setting *made
+ * if it's new (asyncdrop must then be called when interp goes away);
+ * NULL if out of memory
+ */
+static SHAOWNER *asyncowner(void *interp, int *made)
+{
+	SHAOWNER *o;
+
+	*made = 0;
+	ASYNC_LOCK();
+	for (o = asyncowners; o != NULL; o = o->next)
+		if (o->interp == interp && !o->dead)
+			break;
+	if (o == NULL && (o = (SHAOWNER *)
+		calloc(1, sizeof(SHAOWNER))) != NULL) {
+		o->interp = interp;
+		o->pipe[0] = o->pipe[1] = -1;
+		o->next = asyncowners;
+		asyncowners = o;
+		*made = 1;
+	}
+	ASYNC_UNLOCK();
+	return(o);
+}
+
+/*
+ * asyncdrop: forgets the owner for interpreter interp, which is being
+ * destroyed; jobs still running free themselves, and the last of them
+ * frees the owner
+ */
+static void asyncdrop(void *interp)
+{
+	SHAOWNER *o;
+	SHAJOB *done, *reaped;
+
+	ASYNC_LOCK();
+	for (o = asyncowners; o != NULL; o = o->next)
+		if (o->interp == interp && !o->dead)
+			break;
+	if (o == NULL) {
+		ASYNC_UNLOCK();
+		return;
+	}
+	o->dead = 1;
+	asyncclose(o);
+	done = o->done, reaped = o->reaped;
+	o->done = o->reaped = o->reapedtail = NULL;
+	if (o->pending == 0)
+		asyncunlink(o);
+	else
+		o = NULL;
+	ASYNC_UNLOCK();
+	asyncfreelist(done);
+	asyncfreelist(reaped);
+	free(o);
+}
+
+/* asyncfinished: hands finished job j to its owner (lock held) */
+static void asyncfinished(SHAJOB *j)
+{
+	SHAOWNER *o = j->owner;
+	char c = 1;
+
+	o->pending--;
+	if (o->dead) {
+		asyncfree(j);
+		if (o->pending == 0) {
+			asyncunlink(o);
+			free(o);
+		}
+		return;
+	}
+	j->next = o->done;
+	o->done = j;
+	if (!o->signaled && o->pipe[1] >= 0 && write(o->pipe[1], &c, 1) == 1)
+		o->signaled = 1;
+}
+
+/*
+ * asyncreap: moves the finished jobs of owner o to its reaped list, in
+ * the order they finished, and returns the first of them (the
+ * rest follow by next), or NULL if none; only o's interpreter may walk
+ * or change the reaped list
+ */
+static SHAJOB *asyncreap(SHAOWNER *o)
+{
+	SHAJOB *j, *first = NULL;
+	char buf[16];
+
+	ASYNC_LOCK();
+	if (o->pipe[0] >= 0)
+		while (read(o->pipe[0], buf, sizeof(buf)) > 0)
+			;
+	o->signaled = 0;
+	while ((j = o->done) != NULL) {
+		o->done = j->next;
+		j->next = first;
+		first = j;
+	}
+	ASYNC_UNLOCK();
+	if (first != NULL) {
+		for (j = first; j->next != NULL; j = j->next)
+			;
+		if (o->reapedtail != NULL)
+			o->reapedtail->next = first;
+		else
+			o->reaped = first;
+		o->reapedtail = j;
+	}
+	return(first);
+}
+
+/* asynctake: removes reaped job id from owner o; NULL if no such job */
+static SHAJOB *asynctake(SHAOWNER *o, ULNG id)
+{
+	SHAJOB **p, *j = NULL, *prev = NULL;
+
+	for (p = &o->reaped; *p != NULL; prev = *p, p = &(*p)->next)
+		if ((*p)->id == id) {
+			j = *p;
+			*p = j->next;
+			if (o->reapedtail == j)
+				o->reapedtail = prev;
+			j->next = NULL;
+			break;
+		}
+	return(j);
+}
+
+#ifdef SHA_THREADS
+
+/* asyncworker: runs queued jobs for as long as the process lives */
+static void *asyncworker(void *arg)
+{
+	SHAJOB *j;
+
+	(void) arg;
+	for (;;) {
+		pthread_mutex_lock(&asynclock);
+		while (asynchead == NULL) {
+			asyncidle++;
+			pthread_cond_wait(&asyncwork, &asynclock);
+			asyncidle--;
+		}
+		j = asynchead;
+		if ((asynchead = j->next) == NULL)
+			asynctail = NULL;
+		pthread_mutex_unlock(&asynclock);
+
+		asyncrun(j);
+
+		pthread_mutex_lock(&asynclock);
+		asyncfinished(j);
+		pthread_mutex_unlock(&asynclock);
+	}
+	return(NULL);
+}
+
+/*
+ * asyncchild: forgets the pool in a child process after fork, where
+ * the workers don't exist; jobs that were pending are finished only
+ * in the parent, and each owner gets a pipe of its own when needed
+ */
+static void asyncchild(void)
+{
+	pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+	pthread_cond_t work = PTHREAD_COND_INITIALIZER;
+	SHAOWNER *o;
+
+	asynclock = lock;
+	asyncwork = work;
+	asynchead = asynctail = NULL;
+	asyncthreads = asyncidle = 0;
+	for (o = asyncowners; o != NULL; o = o->next)
+		asyncclose(o);
+}
+
+/* asyncpipeinit: creates the pipe of owner o (lock held); 0 on error */
+static int asyncpipeinit(SHAOWNER *o)
+{
+	int i;
+
+	if (o->pipe[0] >= 0)
+		return(1);
+	if (!asynchooked) {
+		if (pthread_atfork(NULL, NULL, asyncchild) != 0)
+			return(0);
+		asynchooked = 1;
+	}
+	if (pipe(o->pipe) != 0) {
+		o->pipe[0] = o->pipe[1] = -1;
+		return(0);
+	}
+	for (i = 0; i < 2; i++) {
+		fcntl(o->pipe[i], F_SETFL,
+			fcntl(o->pipe[i], F_GETFL) | O_NONBLOCK);
+		fcntl(o->pipe[i], F_SETFD, FD_CLOEXEC);
+	}
+	return(1);
+}
+
+/* asyncfd: returns the read end of the pipe of owner o, or -1 */
+static int asyncfd(SHAOWNER *o)
+{
+	int fd;
+
+	pthread_mutex_lock(&asynclock);
+	fd = asyncpipeinit(o) ? o->pipe[0] : -1;
+	pthread_mutex_unlock(&asynclock);
+	return(fd);
+}
+
+/* asyncmax: sets the most workers to run (if n > 0); returns it */
+static int asyncmax(int n)
+{
+	pthread_mutex_lock(&asynclock);
+	if (n > 0)
+		asyncmaxthreads = n > SHA_MAX_THREADS ? SHA_MAX_THREADS : n;
+	n = asyncmaxthreads > 0 ? asyncmaxthreads : shancpu();
+	pthread_mutex_unlock(&asynclock);
+	return(n);
+}
+
+/*
+ * asyncsubmit: numbers job j and queues it, starting a worker if none
+ * is idle and there are fewer than asyncmax; returns 0 (with j not
+ * queued) if no worker could be started or the pipe can't be made
+ */
+static int asyncsubmit(SHAJOB *j)
+{
+	SHAOWNER *o = j->owner;
+	pthread_t tid;
+	pthread_attr_t attr;
+	int max, ok = 1;
+
+	max = asyncmax(0);
+	pthread_mutex_lock(&asynclock);
+	if (!asyncpipeinit(o)) {
+		pthread_mutex_unlock(&asynclock);
+		return(0);
+	}
+	if (asyncidle == 0 && asyncthreads < max) {
+		pthread_attr_init(&attr);
+		pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+		if (pthread_create(&tid, &attr, asyncworker, NULL) == 0)
+			asyncthreads++;
+		else
+			ok = asyncthreads > 0;
+		pthread_attr_destroy(&attr);
+	}
+	if (ok) {
+		j->id = ++o->lastid;
+		o->pending++;
+		j->next = NULL;
+		if (asynctail != NULL)
+			asynctail->next = j;
+		else
+			asynchead = j;
+		asynctail = j;
+		pthread_cond_signal(&asyncwork);
+	}
+	pthread_mutex_unlock(&asynclock);
+	return(ok);
+}
+
+#else
+
+#define asyncfd(o)	-1
+#define asyncmax(n)	1
+
+/* asyncsubmit: numbers job j and runs it at once, for lack of threads */
+static int asyncsubmit(SHAJOB *j)
+{
+	j->id = ++j->owner->lastid;
+	j->owner->pending++;
+	asyncrun(j);
+	asyncfinished(j);
+	return(1);
+}
+
+#endif	/* #ifdef SHA_THREADS */
@@ -0,0 +1,363 @@
+/*
+ * shacache.c: persistent cache of file states, keyed by file identity
+ *
+ * Copyright (C) 2003-2014 Mark Shelor, All Rights Reserved
+ *
+ * The cache file is an open-addressing hash table that's mapped into
+ * memory.  Each slot holds the identity of a file (device, inode, size,
+ * and modification/change times), the algorithm and addfile mode, and
+ * the state after reading the file, packed by shapack().  Words are
+ * stored big-endian, as in the packed state itself.
+ *
+ * fcntl() locks serialize access between processes.  Since those locks
+ * don't exclude threads of the same process, a mutex is held as well.
+ *
+ */
+
+#if defined(HAS_MMAP) && defined(F_SETLKW)
+	#define SHA_CACHE
+#endif
+
+#define CACHE_MAGIC	"SHAcache"
+#define CACHE_VERSION	1
+#define CACHE_HDR_LEN	64	/* magic, version, nslots, nused */
+#define CACHE_KEY_LEN	52	/* 13 words: see cachekey */
+#define CACHE_SLOT_LEN	288	/* key, alg, mode, len, check, state */
+#define CACHE_MIN_SLOTS	1024	/* power of 2 */
+#define CACHE_RACY	2	/* default seconds a file must be left alone */
+
+#define KEYHI(x)	((W32) ((((x) >> 16) >> 16) & SHA32_MAX))
+#define KEYLO(x)	((W32) ((x) & SHA32_MAX))
+
+#if defined(st_mtime) && defined(__APPLE__)
+	#define ST_MNSEC(st)	((st)->st_mtimespec.tv_nsec)
+	#define ST_CNSEC(st)	((st)->st_ctimespec.tv_nsec)
+#elif defined(st_mtime)
+	#define ST_MNSEC(st)	((st)->st_mtim.tv_nsec)
+	#define ST_CNSEC(st)	((st)->st_ctim.tv_nsec)
+#else
+	#define ST_MNSEC(st)	0
+	#define ST_CNSEC(st)	0
+#endif
+
+typedef struct {
+	int fd;
+	UCHR *map;
+	size_t maplen;
+	W32 nslots;
+	W32 racy;		/* seconds a file must be left alone */
+} SHACACHE;
+
+/* cachekey: packs identity of a regular file into key (0 = not regular) */
+static int cachekey(struct stat *st, UCHR *key)
+{
+	if (!S_ISREG(st->st_mode))
+		return(0);
+	key = w32mem(key, KEYHI(st->st_dev));
+	key = w32mem(key, KEYLO(st->st_dev));
+	key = w32mem(key, KEYHI(st->st_ino));
+	key = w32mem(key, KEYLO(st->st_ino));
+	key = w32mem(key, KEYHI(st->st_size));
+	key = w32mem(key, KEYLO(st->st_size));
+	key = w32mem(key, KEYHI(st->st_mtime));
+	key = w32mem(key, KEYLO(st->st_mtime));
+	key = w32mem(key, (W32) ST_MNSEC(st));
+	key = w32mem(key, KEYHI(st->st_ctime));
+	key = w32mem(key, KEYLO(st->st_ctime));
+	key = w32mem(key, (W32) ST_CNSEC(st));
+	w32mem(key, 0);
+	return(1);
+}
+
+#ifdef SHA_CACHE
+
+#ifdef SHA_THREADS
+static pthread_mutex_t cachemutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* fnv: FNV-1a hash of len bytes, continuing from h */
+static W32 fnv(W32 h, UCHR *p, size_t len)
+{
+	while (len--)
+		h = (h ^ *p++) * 16777619UL & SHA32_MAX;
+	return(h);
+}
+
+/* slotcheck: computes check word over key, mode, and state of slot */
+static W32 slotcheck(UCHR *slot)
+{
+	W32 h = fnv(2166136261UL, slot, CACHE_KEY_LEN);
+
+	h = fnv(h, slot + 56, 8);
+	return(fnv(h, slot + 68, memw32(slot + 60)));
+}
+
+/* cachemap: (re)maps whole table after size was read from header */
+static int cachemap(SHACACHE *c, W32 nslots)
+{
+	size_t len = CACHE_HDR_LEN + (size_t) nslots * CACHE_SLOT_LEN;
+	struct stat st;
+	UCHR *map;
+
+	if (c->map != NULL && c->maplen == len) {
+		c->nslots = nslots;
+		return(1);
+	}
+	if (fstat(c->fd, &st) != 0 || (size_t) st.st_size < len)
+		return(0);
+	map = (UCHR *) mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED,
+		c->fd, 0);
+	if (map == (UCHR *) MAP_FAILED)
+		return(0);
+	if (c->map != NULL)
+		munmap((Mmap_t) c->map, c->maplen);
+	c->map = map;
+	c->maplen = len;
+	c->nslots = nslots;
+	return(1);
+}
+
+/* cacheinit: empties table and sizes it for nslots (lock held) */
+static int cacheinit(SHACACHE *c, W32 nslots)
+{
+	UCHR hdr[CACHE_HDR_LEN];
+
+	if (c->map != NULL) {
+		munmap((Mmap_t) c->map, c->maplen);
+		c->map = NULL;
+	}
+	if (ftruncate(c->fd, 0) != 0 || ftruncate(c->fd, (Off_t)
+		(CACHE_HDR_LEN + (size_t) nslots * CACHE_SLOT_LEN)) != 0)
+		return(0);
+	Zero(hdr, CACHE_HDR_LEN, UCHR);
+	Copy(CACHE_MAGIC, hdr, 8, char);
+	w32mem(hdr + 8, CACHE_VERSION);
+	w32mem(hdr + 12, nslots);
+	if (!cachemap(c, nslots))
+		return(0);
+	Copy(hdr, c->map, CACHE_HDR_LEN, UCHR);
+	return(1);
+}
+
+/* cachelock: locks table for reading (F_RDLCK) or writing (F_WRLCK) */
+static int cachelock(SHACACHE *c, int type)
+{
+	struct flock fl;
+	struct stat st;
+	W32 nslots;
+	size_t len;
+
+#ifdef SHA_THREADS
+	pthread_mutex_lock(&cachemutex);
+#endif
+	Zero(&fl, 1, struct flock);
+	fl.l_type = type;
+	fl.l_whence = SEEK_SET;
+	while (fcntl(c->fd, F_SETLKW, &fl) != 0)
+		if (errno != EINTR)
+			goto fail;
+
+		/* another process may have grown or rebuilt the table,
+		   so check the file size before touching the mapping */
+
+	if (c->map == NULL)
+		return(1);
+	if (fstat(c->fd, &st) != 0 || st.st_size < CACHE_HDR_LEN)
+		goto unlock;
+	if (memcmp(c->map, CACHE_MAGIC, 8) != 0)
+		goto unlock;
+	nslots = memw32(c->map + 12);
+	len = CACHE_HDR_LEN + (size_t) nslots * CACHE_SLOT_LEN;
+	if (nslots >= CACHE_MIN_SLOTS && !(nslots & (nslots - 1)) &&
+		(size_t) st.st_size >= len && cachemap(c, nslots))
+		return(1);
+unlock:
+	fl.l_type = F_UNLCK;
+	fcntl(c->fd, F_SETLK, &fl);
+fail:
+#ifdef SHA_THREADS
+	pthread_mutex_unlock(&cachemutex);
+#endif
+	return(0);
+}
+
+/* cacheunlock: releases lock taken by cachelock */
+static void cacheunlock(SHACACHE *c)
+{
+	struct flock fl;
+
+	Zero(&fl, 1, struct flock);
+	fl.l_type = F_UNLCK;
+	fl.l_whence = SEEK_SET;
+	fcntl(c->fd, F_SETLK, &fl);
+#ifdef SHA_THREADS
+	pthread_mutex_unlock(&cachemutex);
+#endif
+}
+
+/* cacheslot: finds slot for file identity, or empty slot to store it */
+static UCHR *cacheslot(SHACACHE *c, UCHR *key, W32 alg, W32 mode)
+{
+	UCHR id[8];
+	UCHR *slot;
+	W32 i, n;
+
+	w32mem(id, alg);
+	w32mem(id + 4, mode);
+	i = fnv(fnv(2166136261UL, key, 16), id, 8);
+	for (n = 0; n < c->nslots; n++, i++) {
+		slot = c->map + CACHE_HDR_LEN +
+			(size_t) (i & (c->nslots - 1)) * CACHE_SLOT_LEN;
+		if (memw32(slot + 52) == 0)
+			return(slot);
+		if (memcmp(slot, key, 16) == 0 && memcmp(slot + 52, id, 8) == 0)
+			return(slot);
+	}
+	return(NULL);
+}
+
+/*
+ * cacheopen: opens (or creates) cache file, emptying it if rebuild is
+ * set; fails with EINVAL rather than overwrite a file that isn't a cache
+ */
+static int cacheopen(SHACACHE *c, char *path, int rebuild)
+{
+	struct stat st;
+	UCHR hdr[CACHE_HDR_LEN];
+	W32 nslots = 0;
+	int ok, err;
+
+	c->map = NULL;
+	c->nslots = 0;
+	c->racy = CACHE_RACY;
+	if ((c->fd = open(path, O_RDWR | O_CREAT | O_BINARY, 0666)) < 0)
+		return(0);
+	if (!cachelock(c, F_WRLCK)) {
+		err = errno;
+		close(c->fd);
+		errno = err;
+		return(0);
+	}
+	ok = fstat(c->fd, &st) == 0;
+	Zero(hdr, CACHE_HDR_LEN, UCHR);
+	if (ok && st.st_size > 0 && (read(c->fd, hdr, CACHE_HDR_LEN) !=
+		CACHE_HDR_LEN || memcmp(hdr, CACHE_MAGIC, 8) != 0)) {
+		ok = 0;
+		errno = EINVAL;
+	}
+	if (ok) {
+		nslots = memw32(hdr + 12);
+		if (rebuild || memw32(hdr + 8) != CACHE_VERSION ||
+			nslots < CACHE_MIN_SLOTS || (nslots & (nslots - 1)) ||
+			!cachemap(c, nslots))
+			ok = cacheinit(c, CACHE_MIN_SLOTS);
+	}
+	err = errno;
+	cacheunlock(c);
+	if (!ok) {
+		if (c->map != NULL)
+			munmap((Mmap_t) c->map, c->maplen);
+		close(c->fd);
+		errno = err;
+	}
+	return(ok);
+}
+
+/* cacheclose: unmaps and closes cache file */
+static void cacheclose(SHACACHE *c)
+{
+	if (c->map != NULL)
+		munmap((Mmap_t) c->map, c->maplen);
+	close(c->fd);
+}
+
+/* cacheget: copies cached state for key into state; returns its length */
+static UINT cacheget(SHACACHE *c, UCHR *key, int alg, int mode,
+	UCHR *state)
+{
+	UCHR *slot;
+	UINT len = 0;
+
+	if (!cachelock(c, F_RDLCK))
+		return(0);
+	slot = cacheslot(c, key, (W32) alg, (W32) mode);
+	if (slot != NULL && memw32(slot + 52) != 0
+		&& memcmp(slot, key, CACHE_KEY_LEN) == 0
+		&& memw32(slot + 60) <= SHA_MAX_STATE_LEN
+		&& memw32(slot + 64) == slotcheck(slot)) {
+		len = (UINT) memw32(slot + 60);
+		Copy(slot + 68, state, len, UCHR);
+	}
+	cacheunlock(c);
+	return(len);
+}
+
+/* cachegrow: doubles number of slots, rehashing entries (lock held) */
+static int cachegrow(SHACACHE *c)
+{
+	W32 i, nused = 0, nslots = c->nslots;
+	size_t len = (size_t) nslots * CACHE_SLOT_LEN;
+	UCHR *old, *slot, *to;
+
+	if ((old = (UCHR *) malloc(len)) == NULL)
+		return(0);
+	Copy(c->map + CACHE_HDR_LEN, old, len, UCHR);
+	if (!cacheinit(c, nslots * 2) && !cacheinit(c, nslots)) {
+		free(old);
+		return(0);
+	}
+	for (i = 0, slot = old; i < nslots; i++, slot += CACHE_SLOT_LEN) {
+		if (memw32(slot + 52) == 0)
+			continue;
+		if ((to = cacheslot(c, slot, memw32(slot + 52),
+			memw32(slot + 56))) == NULL)
+			break;
+		Copy(slot, to, CACHE_SLOT_LEN, UCHR);
+		nused++;
+	}
+	w32mem(c->map + 16, nused);
+	free(old);
+	return(1);
+}
+
+/*
+ * cacheput: stores state for key, unless the file changed too recently
+ * to trust its timestamps (it could change again within the same tick)
+ */
+static int cacheput(SHACACHE *c, UCHR *key, int alg, int mode,
+	UCHR *state, UINT len)
+{
+	UCHR *slot;
+	W32 nused;
+	W32 now = (W32) time(NULL);
+
+	if (len > SHA_MAX_STATE_LEN || alg == 0)
+		return(0);
+	if (memw32(key + 28) + c->racy > now ||
+		memw32(key + 40) + c->racy > now)
+		return(0);
+	if (!cachelock(c, F_WRLCK))
+		return(0);
+	nused = memw32(c->map + 16);
+	if ((nused + 1) * 4 > c->nslots * 3 && !cachegrow(c)) {
+		cacheunlock(c);
+		return(0);
+	}
+	if ((slot = cacheslot(c, key, (W32) alg, (W32) mode)) == NULL) {
+		cacheunlock(c);
+		return(0);
+	}
+	if (memw32(slot + 52) == 0)
+		w32mem(c->map + 16, memw32(c->map + 16) + 1);
+	w32mem(slot + 52, 0);
+	Copy(key, slot, CACHE_KEY_LEN, UCHR);
+	w32mem(slot + 56, (W32) mode);
+	w32mem(slot + 60, len);
+	Copy(state, slot + 68, len, UCHR);
+	w32mem(slot + 64, slotcheck(slot));
+	w32mem(slot + 52, (W32) alg);
+	cacheunlock(c);
+	return(1);
+}
+
+#endif	/* #ifdef SHA_CACHE */
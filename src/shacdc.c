@@ -0,0 +1,168 @@
+/*
+ * shacdc.c: content-defined chunking with a digest for every chunk
+ *
+ * Copyright (C) 2003-2014 Mark Shelor, All Rights Reserved
+ *
+ * Boundaries are found FastCDC-style with a gear hash: for each byte b,
+ * fp = (fp << 1) + gear[b], using 32-bit arithmetic, where gear[b] is
+ * the first 32 bits (big-endian) of SHA-256 applied to the single byte
+ * b.  The first minsize bytes of a chunk are skipped, fp starts at 0
+ * after them, and a chunk ends after the first byte that leaves zero
+ * in the masked bits of fp.  Up to avgsize bytes the mask has the top
+ * log2(avgsize) + 2 bits set; after that it has log2(avgsize) - 2
+ * bits ("normalized chunking"), and a chunk ends regardless at maxsize.
+ * Since they decide where chunks fall, these rules are part of the
+ * format and mustn't change.
+ *
+ */
+
+#define SHA_CDC_MIN		2048	/* default chunk sizes */
+#define SHA_CDC_AVG		8192
+#define SHA_CDC_MAX		65536
+#define SHA_CDC_MAX_LIMIT	SHA_MAP_WINDOW	/* bit count fits a ULNG */
+
+/* SHACDC: chunker state, with the digest of the chunk in progress */
+typedef struct {
+	int alg;
+	int format;		/* 0 = binary, 1 = hex, 2 = base64 */
+	UINT minsize, avgsize, maxsize;
+	W32 masks, maskl;	/* masks before/after avgsize */
+	W32 gear[256];
+	SHA sha;		/* digest of current chunk */
+	W32 fp;			/* gear hash */
+	UINT len;		/* bytes in current chunk */
+	W32 offhi, offlo;	/* stream offset of current chunk */
+} SHACDC;
+
+/* cdcmask: returns 32-bit mask with the top nbits bits set */
+static W32 cdcmask(int nbits)
+{
+	return(nbits >= 32 ? SHA32_MAX : SHA32_MAX ^ (SHA32_MAX >> nbits));
+}
+
+/* cdcinit: initializes chunker state; returns NULL on bad parameters */
+static SHACDC *cdcinit(SHACDC *c, int alg, UINT minsize, UINT avgsize,
+	UINT maxsize)
+{
+	SHA g;
+	UCHR b;
+	int i, bits;
+
+	Zero(c, 1, SHACDC);
+	if (!shainit(&c->sha, alg) || !shainit(&g, SHA256))
+		return(NULL);
+	if (avgsize < 256 || (avgsize & (avgsize - 1)) ||
+		minsize < 64 || minsize >= avgsize || maxsize <= avgsize ||
+		maxsize > SHA_CDC_MAX_LIMIT)
+		return(NULL);
+	for (bits = 0; ((UINT) 1 << bits) < avgsize; bits++)
+		;
+	c->alg = alg;
+	c->minsize = minsize;
+	c->avgsize = avgsize;
+	c->maxsize = maxsize;
+	c->masks = cdcmask(bits + 2);
+	c->maskl = cdcmask(bits - 2);
+	for (i = 0; i < 256; i++) {
+		shainit(&g, SHA256);
+		b = (UCHR) i;
+		shawrite(&b, 8, &g);
+		shafinish(&g);
+		c->gear[i] = memw32(digcpy(&g));
+	}
+	return(c);
+}
+
+/* cdcnext: starts the chunk that follows the current one */
+static void cdcnext(SHACDC *c)
+{
+	W32 lo = c->offlo;
+
+	if ((c->offlo = SHA_LO32(c->offlo + c->len)) < lo)
+		c->offhi++;
+	shainit(&c->sha, c->alg);
+	c->len = 0;
+	c->fp = 0;
+}
+
+/* cdcreset: discards current chunk and starts a new stream at offset 0 */
+static void cdcreset(SHACDC *c)
+{
+	shainit(&c->sha, c->alg);
+	c->len = 0;
+	c->fp = 0;
+	c->offhi = c->offlo = 0;
+}
+
+/*
+ * cdcscan: runs the gear hash over p .. lim-1 until a byte leaves the
+ * masked bits of the hash zero, and returns the position just after
+ * that byte (setting *found), or lim
+ *
+ * Two bytes are rolled in per step: the hash after the second byte is
+ * (fp << 2) + (gear[b0] << 1) + gear[b1], which doesn't wait for the
+ * hash after the first, so the loop's dependency chain is half as long.
+ */
+static UCHR *cdcscan(UCHR *p, UCHR *lim, W32 mask, W32 *gear, W32 *fpp,
+	int *found)
+{
+	W32 fp = *fpp, f1, g0, g1;
+
+	*found = 1;
+	for (; lim - p >= 2; p += 2) {
+		g0 = gear[p[0]];
+		g1 = gear[p[1]];
+		f1 = (fp << 1) + g0;
+		fp = (fp << 2) + (g0 << 1) + g1;
+		if ((f1 & mask) == 0) {
+			*fpp = f1;
+			return(p + 1);
+		}
+		if ((fp & mask) == 0) {
+			*fpp = fp;
+			return(p + 2);
+		}
+	}
+	if (p < lim) {
+		fp = (fp << 1) + gear[*p++];
+		if ((fp & mask) == 0) {
+			*fpp = fp;
+			return(p);
+		}
+	}
+	*found = 0;
+	*fpp = fp;
+	return(p);
+}
+
+#define CDCLEN		(c->len + (UINT) (p - data))
+#define CDCLIM(size)	((size_t) (end - p) > (size_t) ((size) - CDCLEN) ? \
+				p + ((size) - CDCLEN) : end)
+
+/*
+ * cdcwrite: consumes data up to the end of the current chunk, or all
+ * nbytes if the chunk doesn't end there, and returns the number of
+ * bytes consumed; *done is set if the chunk ended, in which case the
+ * caller finishes c->sha, collects the chunk (offset c->offhi/offlo,
+ * length c->len, and digest), and then calls cdcnext
+ */
+static size_t cdcwrite(SHACDC *c, UCHR *data, size_t nbytes, int *done)
+{
+	UCHR *p = data;
+	UCHR *end = data + nbytes;
+	W32 fp = c->fp;
+
+	*done = 0;
+	if (CDCLEN < c->minsize)
+		p = CDCLIM(c->minsize);
+	if (p < end && CDCLEN < c->avgsize)
+		p = cdcscan(p, CDCLIM(c->avgsize), c->masks, c->gear, &fp, done);
+	if (!*done && p < end && CDCLEN < c->maxsize)
+		p = cdcscan(p, CDCLIM(c->maxsize), c->maskl, c->gear, &fp, done);
+	if (CDCLEN == c->maxsize)
+		*done = 1;
+	shawrite(data, (ULNG) (p - data) << 3, &c->sha);
+	c->fp = SHA_LO32(fp);
+	c->len = CDCLEN;
+	return((size_t) (p - data));
+}
@@ -0,0 +1,214 @@
+/*
+ * shackpt.c: binary checkpoints of SHA state, singly or in slab files
+ *
+ * Copyright (C) 2003-2014 Mark Shelor, All Rights Reserved
+ *
+ * A checkpoint is a fixed 256-byte record: the magic "SHAk", a format
+ * version, the length of the packed state, the algorithm, the state
+ * packed by shapack() (zero-filled past 116 bytes for SHA-1/224/256),
+ * and a CRC-32 (as in zlib) of everything before it.  A slab file is a
+ * 64-byte header (magic "SHAslab", version, record count and length,
+ * and a CRC-32 of the header) followed by that many records, so any
+ * record can be located without reading the ones before it.  Words
+ * are stored big-endian, as in the packed state itself.
+ *
+ */
+
+#define CKPT_MAGIC	"SHAk"
+#define CKPT_VERSION	1
+#define CKPT_LEN	256	/* magic, version, len, alg, state, crc */
+#define CKPT_STATE	16	/* offset of packed state */
+#define CKPT_CRC	(CKPT_LEN - 4)
+#define SLAB_MAGIC	"SHAslab"
+#define SLAB_VERSION	1
+#define SLAB_HDR_LEN	64	/* magic, version, nrecs, reclen, crc */
+#define SLAB_MAX_RECS	(1 << 24)
+
+static W32 crctab[256];
+
+/* ckptinit: builds the table for ckptcrc (called once, at load time) */
+static void ckptinit(void)
+{
+	W32 c;
+	int i, k;
+
+	for (i = 0; i < 256; i++) {
+		for (c = (W32) i, k = 0; k < 8; k++)
+			c = c & 1 ? C32(0xedb88320) ^ SR32(c, 1) : SR32(c, 1);
+		crctab[i] = c;
+	}
+}
+
+/* ckptcrc: returns the CRC-32 of len bytes at p */
+static W32 ckptcrc(UCHR *p, size_t len)
+{
+	W32 c = SHA32_MAX;
+
+	while (len--)
+		c = crctab[(c ^ *p++) & 0xff] ^ SR32(c, 8);
+	return(SHA_LO32(c ^ SHA32_MAX));
+}
+
+/* ckptsave: writes a CKPT_LEN-byte checkpoint of s into rec */
+static void ckptsave(SHA *s, UCHR *rec)
+{
+	UINT len;
+
+	Zero(rec, CKPT_LEN, UCHR);
+	Copy(CKPT_MAGIC, rec, 4, char);
+	len = shapack(s, rec + CKPT_STATE);
+	w32mem(rec + 4, (W32) CKPT_VERSION << 16 | len);
+	w32mem(rec + 8, (W32) s->alg);
+	w32mem(rec + CKPT_CRC, ckptcrc(rec, CKPT_CRC));
+}
+
+/* ckptload: restores s from checkpoint rec; leaves s alone if invalid */
+static int ckptload(SHA *s, UCHR *rec, size_t len)
+{
+	SHA t;
+
+	if (len != CKPT_LEN || memcmp(rec, CKPT_MAGIC, 4) != 0)
+		return(0);
+	if (memw32(rec + 4) >> 16 != CKPT_VERSION)
+		return(0);
+	if (memw32(rec + CKPT_CRC) != ckptcrc(rec, CKPT_CRC))
+		return(0);
+	if (!shainit(&t, (int) memw32(rec + 8)))
+		return(0);
+	if (!shaunpack(&t, rec + CKPT_STATE, memw32(rec + 4) & 0xffff))
+		return(0);
+#if defined(SHA_STATS)
+	t.stats = s->stats;
+#endif
+	Copy(&t, s, 1, SHA);
+	return(1);
+}
+
+/* slabhdr: fills in the header of a slab holding nrecs records */
+static void slabhdr(UCHR *hdr, W32 nrecs)
+{
+	Zero(hdr, SLAB_HDR_LEN, UCHR);
+	Copy(SLAB_MAGIC, hdr, 8, char);
+	w32mem(hdr + 8, SLAB_VERSION);
+	w32mem(hdr + 12, nrecs);
+	w32mem(hdr + 16, CKPT_LEN);
+	w32mem(hdr + SLAB_HDR_LEN - 4, ckptcrc(hdr, SLAB_HDR_LEN - 4));
+}
+
+/* slabcheck: returns the record count of a slab header, or -1 */
+static long slabcheck(UCHR *hdr)
+{
+	if (memcmp(hdr, SLAB_MAGIC, 8) != 0)
+		return(-1);
+	if (memw32(hdr + SLAB_HDR_LEN - 4) != ckptcrc(hdr, SLAB_HDR_LEN - 4))
+		return(-1);
+	if (memw32(hdr + 8) != SLAB_VERSION || memw32(hdr + 16) != CKPT_LEN)
+		return(-1);
+	if (memw32(hdr + 12) > SLAB_MAX_RECS)
+		return(-1);
+	return((long) memw32(hdr + 12));
+}
+
+/*
+ * slabsave: writes checkpoints of the n states s[0..n-1] to a new slab
+ * file at path, by mapping the file and filling it in place; returns 1
+ * on success, or 0 with errno set
+ */
+static int slabsave(char *path, SHA **s, int n)
+{
+	size_t len = SLAB_HDR_LEN + (size_t) n * CKPT_LEN;
+	int fd, i, ok, err;
+
+	if (n < 0 || n > SLAB_MAX_RECS) {
+		errno = EINVAL;
+		return(0);
+	}
+	fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_BINARY, 0666);
+	if (fd < 0)
+		return(0);
+	ok = 0;
+#ifdef HAS_MMAP
+	if (ftruncate(fd, (Off_t) len) == 0) {
+		UCHR *map = (UCHR *) mmap(NULL, len, PROT_READ | PROT_WRITE,
+			MAP_SHARED, fd, 0);
+		if (map != (UCHR *) MAP_FAILED) {
+			slabhdr(map, (W32) n);
+			for (i = 0; i < n; i++)
+				ckptsave(s[i], map + SLAB_HDR_LEN +
+					(size_t) i * CKPT_LEN);
+			ok = munmap((Mmap_t) map, len) == 0;
+		}
+	}
+#else
+	{
+		UCHR rec[CKPT_LEN];
+
+		slabhdr(rec, (W32) n);
+		ok = write(fd, rec, SLAB_HDR_LEN) == SLAB_HDR_LEN;
+		for (i = 0; ok && i < n; i++) {
+			ckptsave(s[i], rec);
+			ok = write(fd, rec, CKPT_LEN) == CKPT_LEN;
+		}
+	}
+#endif
+	err = errno;
+	if (close(fd) != 0 && ok)
+		ok = 0, err = errno;
+	errno = err;
+	return(ok);
+}
+
+/*
+ * slabload: maps the slab file at path and calls found(arg, i, rec)
+ * for each of its records in order; returns the number of records, or
+ * -1 with errno set if the file can't be read or isn't a slab
+ */
+static long slabload(char *path, void (*found)(void *, long, UCHR *),
+	void *arg)
+{
+	struct stat st;
+	UCHR hdr[SLAB_HDR_LEN];
+	long i, n;
+	int fd, err;
+
+	if ((fd = open(path, O_RDONLY | O_BINARY)) < 0)
+		return(-1);
+	n = -1;
+	err = EINVAL;
+	if (fstat(fd, &st) != 0)
+		err = errno;
+	else if (read(fd, hdr, SLAB_HDR_LEN) == SLAB_HDR_LEN &&
+		(n = slabcheck(hdr)) >= 0 && (Off_t) (SLAB_HDR_LEN +
+		(size_t) n * CKPT_LEN) > st.st_size)
+		n = -1;
+	if (n > 0) {
+#ifdef HAS_MMAP
+		size_t len = SLAB_HDR_LEN + (size_t) n * CKPT_LEN;
+		UCHR *map = (UCHR *) mmap(NULL, len, PROT_READ, MAP_SHARED,
+			fd, 0);
+
+		if (map == (UCHR *) MAP_FAILED)
+			err = errno, n = -1;
+		else {
+			for (i = 0; i < n; i++)
+				found(arg, i, map + SLAB_HDR_LEN +
+					(size_t) i * CKPT_LEN);
+			munmap((Mmap_t) map, len);
+		}
+#else
+		UCHR rec[CKPT_LEN];
+
+		for (i = 0; i < n; i++) {
+			if (read(fd, rec, CKPT_LEN) != CKPT_LEN) {
+				err = errno ? errno : EIO, n = -1;
+				break;
+			}
+			found(arg, i, rec);
+		}
+#endif
+	}
+	close(fd);
+	if (n < 0)
+		errno = err;
+	return(n);
+}
@@ -0,0 +1,364 @@
+/*
+ * shaio.c: routines to update SHA state directly from file descriptors
+ *
+ * Copyright (C) 2003-2014 Mark Shelor, All Rights Reserved
+ *
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+
+#ifdef SHA_THREADS
+	#include <pthread.h>
+#endif
+
+#ifdef HAS_MMAP
+	#include <sys/mman.h>
+	#if !defined(MAP_FAILED)
+		#define MAP_FAILED	((Mmap_t) -1)
+	#endif
+#endif
+
+#define SHA_READ_SIZE	(1 << 16)
+#define SHA_MAP_WINDOW	(1 << 26)	/* bit count must fit in a ULNG */
+#define SHA_PIPE_BUFS	4		/* default ring for shapipefd */
+#define SHA_PIPE_SIZE	(1 << 20)
+#define SHA_PIPE_ALIGN	4096
+
+#ifndef O_BINARY
+	#define O_BINARY	0
+#endif
+
+/*
+ * shareadfd: updates state with data read from fd until EOF; returns
+ * 1, or -1 on error.  The buffer is on the heap, since this runs on
+ * pool threads, whose stacks may be small.
+ */
+static int shareadfd(SHA *s, int fd)
+{
+	UCHR *buf;
+	ssize_t n;
+	int ret = 0, err;
+
+	if ((buf = (UCHR *) malloc(SHA_READ_SIZE)) == NULL) {
+		errno = ENOMEM;
+		return(-1);
+	}
+	while (ret == 0) {
+		if ((n = read(fd, buf, SHA_READ_SIZE)) > 0) {
+			SHA_STAT(s, reads, 1);
+			SHA_STAT(s, readbytes, n);
+			shawrite(buf, (ULNG) n << 3, s);
+		}
+		else if (n == 0)
+			ret = 1;
+		else if (errno != EINTR)
+			ret = -1;
+	}
+	err = errno;
+	free(buf);
+	errno = err;
+	return(ret);
+}
+
+/*
+ * univnl: converts the n bytes at buf to UNIX newlines in place, and
+ * returns the converted length; a CR is dropped if an LF follows it,
+ * or in portable mode if CR LF follows it, and becomes an LF otherwise
+ *
+ * If more data follows, the trailing CRs whose fate isn't known yet
+ * (at most 2) are left out, and their count is returned in *held;
+ * the caller puts them back in front of the next data.  The bytes
+ * between CRs are found with memchr, which libraries vectorize, and
+ * aren't moved at all until a CR has been dropped.
+ */
+static size_t univnl(UCHR *buf, size_t n, int portable, int more,
+	UINT *held)
+{
+	UCHR *src = buf, *dst = buf, *end = buf + n;
+	UCHR *cr;
+	size_t len;
+
+	*held = 0;
+	while ((cr = (UCHR *) memchr(src, '\015', end - src)) != NULL) {
+		if ((len = (size_t) (cr - src)) > 0 && dst != src)
+			Move(src, dst, len, UCHR);
+		dst += len;
+		src = cr + 1;
+		if (src == end && more) {
+			*held = 1;
+			return((size_t) (dst - buf));
+		}
+		if (portable && src + 1 == end && *src == '\015' && more) {
+			*held = 2;
+			return((size_t) (dst - buf));
+		}
+		if (src < end && (*src == '\012' || (portable &&
+			*src == '\015' && src + 1 < end && src[1] == '\012')))
+			continue;
+		*dst++ = '\012';
+	}
+	if ((len = (size_t) (end - src)) > 0 && dst != src)
+		Move(src, dst, len, UCHR);
+	return((size_t) (dst + len - buf));
+}
+
+/*
+ * shamapfd: updates state with the contents of regular file fd,
+ * starting at offset pos, by mapping it into memory in windows
+ *
+ * Returns 0 without touching the state if the file can't be mapped
+ * (e.g. pipes, terminals, or platforms without mmap), 1 on success,
+ * and -1 on a read error after the state has been updated.
+ */
+static int shamapfd(SHA *s, int fd, Off_t pos)
+{
+#ifdef HAS_MMAP
+	struct stat st;
+	Off_t off;
+	size_t len, skip;
+	UCHR *map;
+	long pagesize = 4096;
+
+	if (fd < 0 || pos < 0 || fstat(fd, &st) != 0)
+		return(0);
+	if (!S_ISREG(st.st_mode) || pos >= st.st_size)
+		return(0);
+#if defined(HAS_SYSCONF) && defined(_SC_PAGESIZE)
+	if ((pagesize = sysconf(_SC_PAGESIZE)) <= 0)
+		pagesize = 4096;
+#endif
+	for (off = pos - pos % pagesize; off < st.st_size; off += len) {
+		len = st.st_size - off < SHA_MAP_WINDOW ?
+			(size_t) (st.st_size - off) : SHA_MAP_WINDOW;
+		skip = pos > off ? (size_t) (pos - off) : 0;
+		map = (UCHR *) mmap(NULL, len, PROT_READ, MAP_SHARED, fd, off);
+		if (map == (UCHR *) MAP_FAILED) {
+			if (off <= pos)
+				return(0);
+			if (lseek(fd, off, SEEK_SET) < 0)
+				return(-1);
+			return(shareadfd(s, fd));
+		}
+#if defined(HAS_MADVISE) && defined(MADV_SEQUENTIAL)
+		madvise((Mmap_t) map, len, MADV_SEQUENTIAL);
+#endif
+		SHA_STAT(s, reads, 1);
+		SHA_STAT(s, readbytes, len - skip);
+		shawrite(map + skip, (ULNG) (len - skip) << 3, s);
+		munmap((Mmap_t) map, len);
+	}
+	return(1);
+#else
+	return(0);
+#endif
+}
+
+#ifdef SHA_THREADS
+
+/* SHAPIPE: ring of buffers shared by reader thread and hashing thread */
+typedef struct {
+	int fd;
+	int nbufs;
+	size_t bufsize;
+	UCHR **buf;
+	ssize_t *len;		/* bytes in buffer (0 = EOF, -1 = error) */
+	int head;		/* next buffer for reader to fill */
+	int tail;		/* next buffer for hasher to consume */
+	int count;		/* filled buffers not yet consumed */
+	int err;
+	pthread_mutex_t lock;
+	pthread_cond_t filled;
+	pthread_cond_t drained;
+} SHAPIPE;
+
+/* pipereader: fills ring buffers from p->fd until EOF or error */
+static void *pipereader(void *arg)
+{
+	SHAPIPE *p = (SHAPIPE *) arg;
+	Off_t ahead;
+	ssize_t n;
+	int i;
+
+	ahead = lseek(p->fd, 0, SEEK_CUR);
+#if defined(POSIX_FADV_SEQUENTIAL)
+	posix_fadvise(p->fd, ahead, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+	for (;;) {
+		pthread_mutex_lock(&p->lock);
+		while (p->count == p->nbufs)
+			pthread_cond_wait(&p->drained, &p->lock);
+		i = p->head;
+		pthread_mutex_unlock(&p->lock);
+
+			/* ask the kernel to start on the buffer after this */
+
+#if defined(POSIX_FADV_WILLNEED)
+		ahead += (Off_t) p->bufsize;
+		posix_fadvise(p->fd, ahead, (Off_t) p->bufsize,
+			POSIX_FADV_WILLNEED);
+#endif
+		while ((n = read(p->fd, p->buf[i], p->bufsize)) < 0 &&
+			errno == EINTR)
+			;
+		pthread_mutex_lock(&p->lock);
+		p->len[i] = n;
+		p->err = n < 0 ? errno : 0;
+		p->head = (i + 1) % p->nbufs;
+		p->count++;
+		pthread_cond_signal(&p->filled);
+		pthread_mutex_unlock(&p->lock);
+		if (n <= 0)
+			return(NULL);
+	}
+}
+
+/* pipefree: releases ring buffers */
+static void pipefree(SHAPIPE *p)
+{
+	int i;
+
+	for (i = 0; i < p->nbufs; i++)
+		free(p->buf[i]);
+	free(p->buf);
+	free(p->len);
+}
+
+/*
+ * shapipefd: updates state with data from fd, starting at offset pos,
+ * while a reader thread fills the next buffers of a ring (double
+ * buffering generalized to nbufs buffers of bufsize bytes)
+ *
+ * Returns 0 without touching the state if fd isn't seekable or the
+ * thread can't be started, 1 on success, and -1 on a read error.
+ */
+static int shapipefd(SHA *s, int fd, Off_t pos, int nbufs, long bufsize)
+{
+	SHAPIPE p;
+	pthread_t reader;
+	ssize_t n;
+	int i;
+
+	if (nbufs <= 0)
+		nbufs = SHA_PIPE_BUFS;
+	nbufs = nbufs < 2 ? 2 : (nbufs > 64 ? 64 : nbufs);
+	if (bufsize <= 0)
+		bufsize = SHA_PIPE_SIZE;
+	bufsize = bufsize > SHA_MAP_WINDOW ? SHA_MAP_WINDOW : bufsize;
+	bufsize = (bufsize + SHA_PIPE_ALIGN - 1) & ~(SHA_PIPE_ALIGN - 1);
+	if (fd < 0 || pos < 0 || lseek(fd, pos, SEEK_SET) != pos)
+		return(0);
+
+	Zero(&p, 1, SHAPIPE);
+	p.fd = fd;
+	p.bufsize = (size_t) bufsize;
+	p.buf = (UCHR **) calloc((size_t) nbufs, sizeof(UCHR *));
+	p.len = (ssize_t *) calloc((size_t) nbufs, sizeof(ssize_t));
+	if (p.buf == NULL || p.len == NULL) {
+		pipefree(&p);
+		return(0);
+	}
+	for (p.nbufs = 0; p.nbufs < nbufs; p.nbufs++) {
+#if defined(_POSIX_ADVISORY_INFO) && _POSIX_ADVISORY_INFO > 0
+		if (posix_memalign((void **) &p.buf[p.nbufs],
+			SHA_PIPE_ALIGN, p.bufsize) != 0)
+			p.buf[p.nbufs] = NULL;
+#else
+		p.buf[p.nbufs] = (UCHR *) malloc(p.bufsize);
+#endif
+		if (p.buf[p.nbufs] == NULL) {
+			pipefree(&p);
+			return(0);
+		}
+	}
+	pthread_mutex_init(&p.lock, NULL);
+	pthread_cond_init(&p.filled, NULL);
+	pthread_cond_init(&p.drained, NULL);
+	if (pthread_create(&reader, NULL, pipereader, &p) != 0) {
+		pthread_mutex_destroy(&p.lock);
+		pthread_cond_destroy(&p.filled);
+		pthread_cond_destroy(&p.drained);
+		pipefree(&p);
+		lseek(fd, pos, SEEK_SET);
+		return(0);
+	}
+	for (;;) {
+		pthread_mutex_lock(&p.lock);
+		while (p.count == 0)
+			pthread_cond_wait(&p.filled, &p.lock);
+		i = p.tail;
+		n = p.len[i];
+		pthread_mutex_unlock(&p.lock);
+		if (n <= 0)
+			break;
+		SHA_STAT(s, reads, 1);
+		SHA_STAT(s, readbytes, n);
+		shawrite(p.buf[i], (ULNG) n << 3, s);
+		pthread_mutex_lock(&p.lock);
+		p.tail = (i + 1) % p.nbufs;
+		p.count--;
+		pthread_cond_signal(&p.drained);
+		pthread_mutex_unlock(&p.lock);
+	}
+	pthread_join(reader, NULL);
+	pthread_mutex_destroy(&p.lock);
+	pthread_cond_destroy(&p.filled);
+	pthread_cond_destroy(&p.drained);
+	pipefree(&p);
+	if (n < 0)
+		errno = p.err;
+	return(n < 0 ? -1 : 1);
+}
+
+#else
+
+#define shapipefd(s, fd, pos, nbufs, bufsize)	0
+
+#endif	/* #ifdef SHA_THREADS */
+
+/* SHAFILES: batch of files to be hashed by shafiles */
+typedef struct {
+	int alg;
+	char **paths;
+	UCHR *states;		/* SHA_MAX_STATE_LEN bytes per file */
+	int *errs;		/* errno per file (0 = success) */
+} SHAFILES;
+
+/* filetask: hashes the i-th file of a batch (runs on a pool thread) */
+static void filetask(void *arg, int i)
+{
+	SHAFILES *f = (SHAFILES *) arg;
+	SHA s;
+	int fd, n;
+
+	f->errs[i] = 0;
+	shainit(&s, f->alg);
+	if ((fd = open(f->paths[i], O_RDONLY | O_BINARY)) < 0) {
+		f->errs[i] = errno;
+		return;
+	}
+	if ((n = shamapfd(&s, fd, 0)) == 0)
+		n = shareadfd(&s, fd);
+	if (n < 0)
+		f->errs[i] = errno ? errno : EIO;
+	close(fd);
+	if (!f->errs[i])
+		shapack(&s, f->states + i * SHA_MAX_STATE_LEN);
+}
+
+/*
+ * shafiles: hashes n files, reading them as raw bytes on up to nthreads
+ * threads, and stores the unfinished state of each in shapack() form;
+ * alg must already be known to be valid
+ */
+static void shafiles(int alg, char **paths, int n, int nthreads,
+	UCHR *states, int *errs)
+{
+	SHAFILES f;
+
+	f.alg = alg;
+	f.paths = paths;
+	f.states = states;
+	f.errs = errs;
+	shaparallel(filetask, &f, n, nthreads);
+}
@@ -0,0 +1,237 @@
+/*
+ * shamulti.c: multi-buffer SHA-1/224/256 for independent messages
+ *
+ * Ref: NIST FIPS PUB 180-4 Secure Hash Standard
+ *      Intel Multi-Buffer Hashing (Guilford et al., 2012)
+ *
+ * Copyright (C) 2003-2014 Mark Shelor, All Rights Reserved
+ *
+ * Eight messages are hashed side by side, one per 32-bit lane of an
+ * AVX2 register.  A lane whose message is finished is refilled with
+ * the next message immediately, so lanes stay busy even when message
+ * lengths differ.  Without AVX2 (or with SHA-NI, which is faster per
+ * message) the messages are simply hashed one after another.
+ *
+ */
+
+#define SHA_LANES	8
+
+#ifdef SHA_X86
+
+#define V32		__m256i
+#define VADD(x, y)	_mm256_add_epi32(x, y)
+#define VXOR(x, y)	_mm256_xor_si256(x, y)
+#define VAND(x, y)	_mm256_and_si256(x, y)
+#define VOR(x, y)	_mm256_or_si256(x, y)
+#define VSET(c)		_mm256_set1_epi32((int) (c))
+#define VROTR(x, n)	VOR(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32-(n)))
+#define VROTL(x, n)	VROTR(x, 32-(n))
+#define VSHR(x, n)	_mm256_srli_epi32(x, n)
+
+#define VCh(x, y, z)	VXOR(z, VAND(x, VXOR(y, z)))
+#define VPa(x, y, z)	VXOR(VXOR(x, y), z)
+#define VMa(x, y, z)	VOR(VAND(x, y), VAND(z, VOR(x, y)))
+
+#define VSIGMA0(x)	VXOR(VXOR(VROTR(x, 2), VROTR(x, 13)), VROTR(x, 22))
+#define VSIGMA1(x)	VXOR(VXOR(VROTR(x, 6), VROTR(x, 11)), VROTR(x, 25))
+#define Vsigma0(x)	VXOR(VXOR(VROTR(x, 7), VROTR(x, 18)), VSHR(x,  3))
+#define Vsigma1(x)	VXOR(VXOR(VROTR(x, 17), VROTR(x, 19)), VSHR(x, 10))
+
+/* vsched: loads 32 bytes from each lane's block as 8 big-endian words */
+static void SHA_TARGET("avx2") vsched(V32 *W, UCHR **blk, int off)
+{
+	V32 r[8], t[8], u[8];
+	int i;
+	const V32 bswap = _mm256_set_epi8(
+		12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+		12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+	for (i = 0; i < 8; i++)
+		r[i] = _mm256_loadu_si256((V32 *) (blk[i] + off));
+	for (i = 0; i < 8; i += 2) {
+		t[i]   = _mm256_unpacklo_epi32(r[i], r[i+1]);
+		t[i+1] = _mm256_unpackhi_epi32(r[i], r[i+1]);
+	}
+	for (i = 0; i < 8; i += 4) {
+		u[i]   = _mm256_unpacklo_epi64(t[i],   t[i+2]);
+		u[i+1] = _mm256_unpackhi_epi64(t[i],   t[i+2]);
+		u[i+2] = _mm256_unpacklo_epi64(t[i+1], t[i+3]);
+		u[i+3] = _mm256_unpackhi_epi64(t[i+1], t[i+3]);
+	}
+	for (i = 0; i < 4; i++) {
+		W[i]   = _mm256_permute2x128_si256(u[i], u[i+4], 0x20);
+		W[i+4] = _mm256_permute2x128_si256(u[i], u[i+4], 0x31);
+	}
+	for (i = 0; i < 8; i++)
+		W[i] = _mm256_shuffle_epi8(W[i], bswap);
+}
+
+/* sha1x8: SHA-1 transform of 8 blocks; H holds word t of lane i at [t][i] */
+static void SHA_TARGET("avx2") sha1x8(W32 H[8][SHA_LANES], UCHR **blk)
+{
+	V32 a, b, c, d, e, T;
+	V32 W[16];
+	int t;
+
+	vsched(W, blk, 0);
+	vsched(W+8, blk, 32);
+	a = _mm256_loadu_si256((V32 *) H[0]);
+	b = _mm256_loadu_si256((V32 *) H[1]);
+	c = _mm256_loadu_si256((V32 *) H[2]);
+	d = _mm256_loadu_si256((V32 *) H[3]);
+	e = _mm256_loadu_si256((V32 *) H[4]);
+	for (t = 0; t < 80; t++) {
+		if (t >= 16)
+			W[t&15] = VROTL(VXOR(VXOR(W[(t-3)&15], W[(t-8)&15]),
+				VXOR(W[(t-14)&15], W[t&15])), 1);
+		T = VADD(VADD(VROTL(a, 5), e), W[t&15]);
+		if (t < 20)
+			T = VADD(T, VADD(VCh(b, c, d), VSET(K1)));
+		else if (t < 40)
+			T = VADD(T, VADD(VPa(b, c, d), VSET(K2)));
+		else if (t < 60)
+			T = VADD(T, VADD(VMa(b, c, d), VSET(K3)));
+		else
+			T = VADD(T, VADD(VPa(b, c, d), VSET(K4)));
+		e = d; d = c; c = VROTL(b, 30); b = a; a = T;
+	}
+	_mm256_storeu_si256((V32 *) H[0], VADD(a, _mm256_loadu_si256((V32 *) H[0])));
+	_mm256_storeu_si256((V32 *) H[1], VADD(b, _mm256_loadu_si256((V32 *) H[1])));
+	_mm256_storeu_si256((V32 *) H[2], VADD(c, _mm256_loadu_si256((V32 *) H[2])));
+	_mm256_storeu_si256((V32 *) H[3], VADD(d, _mm256_loadu_si256((V32 *) H[3])));
+	_mm256_storeu_si256((V32 *) H[4], VADD(e, _mm256_loadu_si256((V32 *) H[4])));
+}
+
+/* sha256x8: SHA-224/256 transform of 8 blocks (same layout as sha1x8) */
+static void SHA_TARGET("avx2") sha256x8(W32 H[8][SHA_LANES], UCHR **blk)
+{
+	V32 v[8], T1, T2;
+	V32 W[16];
+	int i, t;
+
+	vsched(W, blk, 0);
+	vsched(W+8, blk, 32);
+	for (i = 0; i < 8; i++)
+		v[i] = _mm256_loadu_si256((V32 *) H[i]);
+	for (t = 0; t < 64; t++) {
+		if (t >= 16)
+			W[t&15] = VADD(VADD(W[t&15], Vsigma0(W[(t-15)&15])),
+				VADD(W[(t-7)&15], Vsigma1(W[(t-2)&15])));
+		T1 = VADD(VADD(v[7], VSIGMA1(v[4])),
+			VADD(VCh(v[4], v[5], v[6]), VADD(VSET(K256[t]), W[t&15])));
+		T2 = VADD(VSIGMA0(v[0]), VMa(v[0], v[1], v[2]));
+		v[7] = v[6]; v[6] = v[5]; v[5] = v[4]; v[4] = VADD(v[3], T1);
+		v[3] = v[2]; v[2] = v[1]; v[1] = v[0]; v[0] = VADD(T1, T2);
+	}
+	for (i = 0; i < 8; i++)
+		_mm256_storeu_si256((V32 *) H[i],
+			VADD(v[i], _mm256_loadu_si256((V32 *) H[i])));
+}
+
+/* LANE: progress of one message through the multi-buffer engine */
+typedef struct {
+	SHA *s;				/* NULL if lane is idle */
+	UCHR *data;			/* next full block of message */
+	size_t nblocks;			/* full blocks left in message */
+	UCHR tail[2*SHA1_BLOCK_BITS/8];	/* padded final block(s) */
+	UINT ntail;			/* tail blocks left */
+	UINT tailpos;
+} LANE;
+
+/* lanefill: starts hashing message (data, len) into s in lane l */
+static void lanefill(LANE *l, W32 H[8][SHA_LANES], int i,
+	SHA *s, UCHR *data, size_t len)
+{
+	int t;
+	UINT rem = (UINT) (len % 64);
+
+	l->s = s;
+	l->data = data;
+	l->nblocks = len / 64;
+	Zero(l->tail, sizeof(l->tail), UCHR);
+	Copy(data + len - rem, l->tail, rem, UCHR);
+	l->tail[rem] = 0x80;
+	l->ntail = rem < 56 ? 1 : 2;
+	l->tailpos = 0;
+	w32mem(l->tail + l->ntail*64 - 8, (W32) ((len >> 16) >> 13));
+	w32mem(l->tail + l->ntail*64 - 4, (W32) ((len << 3) & SHA32_MAX));
+	SHA_STAT(s, blocks, l->nblocks + l->ntail);
+	SHA_STAT(s, direct, len - rem);
+	SHA_STAT(s, partial, 1);
+	SHA_STAT(s, bytes, rem);
+	SHA_STAT(s, finish, 1);
+	for (t = 0; t < 8; t++)
+		H[t][i] = s->H.H32[t];
+}
+
+/* shamultix8: hashes n messages using 8 lanes */
+static void shamultix8(SHA *s, UCHR **data, size_t *len, int n)
+{
+	int i, t, busy;
+	int next = 0;
+	LANE lane[SHA_LANES];
+	UCHR *blk[SHA_LANES];
+	W32 H[8][SHA_LANES];
+	static UCHR idle[SHA1_BLOCK_BITS/8];
+
+	Zero(H, 1, H);
+	for (i = 0; i < SHA_LANES; i++)
+		lane[i].s = NULL;
+	for (;;) {
+		for (busy = i = 0; i < SHA_LANES; i++) {
+			if (lane[i].s == NULL && next < n) {
+				lanefill(&lane[i], H, i,
+					&s[next], data[next], len[next]);
+				next++;
+			}
+			if (lane[i].s == NULL)
+				blk[i] = idle;
+			else if (lane[i].nblocks > 0) {
+				blk[i] = lane[i].data;
+				lane[i].data += 64;
+				lane[i].nblocks--;
+			}
+			else {
+				blk[i] = lane[i].tail + lane[i].tailpos;
+				lane[i].tailpos += 64;
+				lane[i].ntail--;
+			}
+			busy += lane[i].s != NULL;
+		}
+		if (!busy)
+			break;
+		if (s->alg == SHA1)
+			sha1x8(H, blk);
+		else
+			sha256x8(H, blk);
+		for (i = 0; i < SHA_LANES; i++) {
+			if (lane[i].s == NULL || lane[i].nblocks > 0 ||
+				lane[i].ntail > 0)
+				continue;
+			for (t = 0; t < 8; t++)
+				lane[i].s->H.H32[t] = H[t][i];
+			lane[i].s = NULL;
+		}
+	}
+}
+
+#endif	/* #ifdef SHA_X86 */
+
+/* shamulti: computes final states of n messages (s[i] from shainit) */
+static void shamulti(SHA *s, UCHR **data, size_t *len, int n)
+{
+	int i;
+
+	if (n < 1)
+		return;
+#ifdef SHA_X86
+	if (shalanes && s->alg <= SHA256) {
+		shamultix8(s, data, len, n);
+		return;
+	}
+#endif
+	for (i = 0; i < n; i++) {
+		shawritebytes(data[i], len[i], &s[i]);
+		shafinish(&s[i]);
+	}
+}
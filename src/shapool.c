@@ -0,0 +1,99 @@
+/*
+ * shapool.c: runs independent hashing tasks on native worker threads
+ *
+ * Copyright (C) 2003-2014 Mark Shelor, All Rights Reserved
+ *
+ * The tasks must not call back into Perl: they run on threads that
+ * have no interpreter, so they may only use plain C and the routines
+ * in sha.c (which never allocate or croak).
+ *
+ */
+
+#define SHA_MAX_THREADS	256
+
+#ifdef SHA_THREADS
+
+#include <pthread.h>
+
+/* SHAPOOL: shared work counter for one call of shaparallel */
+typedef struct {
+	void (*fn)(void *, int);
+	void *arg;
+	int n;
+	int next;
+	pthread_mutex_t lock;
+} SHAPOOL;
+
+/* poolworker: runs tasks until none are left */
+static void *poolworker(void *arg)
+{
+	SHAPOOL *p = (SHAPOOL *) arg;
+	int i;
+
+	for (;;) {
+		pthread_mutex_lock(&p->lock);
+		i = p->next < p->n ? p->next++ : -1;
+		pthread_mutex_unlock(&p->lock);
+		if (i < 0)
+			return(NULL);
+		p->fn(p->arg, i);
+	}
+}
+
+#endif	/* #ifdef SHA_THREADS */
+
+/*
+ * shaparallel: calls fn(arg, i) for i = 0 .. n-1 using up to nthreads
+ * threads (including the calling thread), and returns when all calls
+ * have finished.  Tasks are handed out in order, one at a time, so
+ * uneven task sizes balance out.  Falls back to a simple loop if
+ * threads are unavailable or can't be started.
+ */
+static void shaparallel(void (*fn)(void *, int), void *arg, int n,
+	int nthreads)
+{
+#ifdef SHA_THREADS
+	SHAPOOL p;
+	pthread_t tid[SHA_MAX_THREADS];
+	int i, started;
+
+	if (nthreads > n)
+		nthreads = n;
+	if (nthreads > SHA_MAX_THREADS)
+		nthreads = SHA_MAX_THREADS;
+	if (nthreads > 1) {
+		p.fn = fn;
+		p.arg = arg;
+		p.n = n;
+		p.next = 0;
+		pthread_mutex_init(&p.lock, NULL);
+		for (started = 0; started < nthreads - 1; started++)
+			if (pthread_create(&tid[started], NULL,
+				poolworker, &p) != 0)
+				break;
+		poolworker(&p);
+		for (i = 0; i < started; i++)
+			pthread_join(tid[i], NULL);
+		pthread_mutex_destroy(&p.lock);
+		return;
+	}
+#endif
+	{
+		int j;
+
+		for (j = 0; j < n; j++)
+			fn(arg, j);
+	}
+}
+
+/* shancpu: returns the number of online processors (at least 1) */
+static int shancpu(void)
+{
+	long n = 1;
+
+#if defined(HAS_SYSCONF) && defined(_SC_NPROCESSORS_ONLN)
+	if ((n = sysconf(_SC_NPROCESSORS_ONLN)) < 1)
+		n = 1;
+#endif
+	return(n > SHA_MAX_THREADS ? SHA_MAX_THREADS : (int) n);
+}
@@ -0,0 +1,273 @@
+/*
+ * shatree.c: tree (Merkle) hashing of long messages on worker threads
+ *
+ * Copyright (C) 2003-2014 Mark Shelor, All Rights Reserved
+ *
+ * The message is cut into leaves of a fixed size (the last leaf may
+ * be shorter, and an empty message is a single empty leaf).  As in
+ * RFC 6962, a leaf hashes to H(0x00 || leaf), two subtrees combine as
+ * H(0x01 || left || right), and a tree of n > 1 leaves splits after
+ * the largest power of two less than n.  The prefixes keep leaf and
+ * node hashes apart, so a tree digest never equals a plain digest.
+ *
+ * Only complete leaves are handed to threads: they're independent,
+ * and the nodes above them are cheap enough to compute in order.
+ *
+ */
+
+#define SHA_TREE_LEAF		(1 << 20)	/* default leaf size */
+#define SHA_TREE_MIN_LEAF	1024
+#define SHA_TREE_MAX_LEAF	(1 << 30)
+#define SHA_TREE_DEPTH		64		/* one subtree per level */
+#define SHA_TREE_BATCH		256		/* leaves per parallel call */
+
+/* SHATREE: tree state, holding the roots of all complete subtrees */
+typedef struct {
+	int alg;
+	ULNG leafsize;
+	int nthreads;
+	SHA leaf;		/* current partial leaf, prefix included */
+	ULNG leaflen;		/* bytes in current partial leaf */
+	int depth;		/* number of complete subtrees */
+	int level[SHA_TREE_DEPTH];	/* subtree holds 2^level leaves */
+	UCHR root[SHA_TREE_DEPTH][SHA_MAX_DIGEST_BITS/8];
+	UCHR batch[SHA_TREE_BATCH][SHA_MAX_DIGEST_BITS/8];
+	SHA result;		/* finished tree digest */
+} SHATREE;
+
+/* SHALEAVES: complete leaves to be hashed by leaftask */
+typedef struct {
+	SHATREE *t;
+	UCHR *data;
+} SHALEAVES;
+
+static UCHR leafprefix[1] = { 0x00 };
+static UCHR nodeprefix[1] = { 0x01 };
+
+/* leaftask: hashes the i-th complete leaf of a batch (on a pool thread) */
+static void leaftask(void *arg, int i)
+{
+	SHALEAVES *l = (SHALEAVES *) arg;
+	SHATREE *t = l->t;
+	SHA s;
+
+	shainit(&s, t->alg);
+	shawrite(leafprefix, 8, &s);
+	shawritebytes(l->data + (ULNG) i * t->leafsize, t->leafsize, &s);
+	shafinish(&s);
+	Copy(digcpy(&s), t->batch[i], s.digestlen, UCHR);
+}
+
+/* treenode: sets out to the hash of interior node (left, right) */
+static void treenode(SHATREE *t, UCHR *left, UCHR *right, UCHR *out)
+{
+	SHA s;
+
+	shainit(&s, t->alg);
+	shawrite(nodeprefix, 8, &s);
+	shawrite(left, s.digestlen << 3, &s);
+	shawrite(right, s.digestlen << 3, &s);
+	shafinish(&s);
+	Copy(digcpy(&s), out, s.digestlen, UCHR);
+}
+
+/* treepush: adds the next leaf hash, merging subtrees of equal size */
+static void treepush(SHATREE *t, UCHR *digest)
+{
+	int d;
+
+	Copy(digest, t->root[t->depth], SHA_MAX_DIGEST_BITS/8, UCHR);
+	t->level[t->depth++] = 0;
+	while ((d = t->depth) > 1 && t->level[d-1] == t->level[d-2]) {
+		treenode(t, t->root[d-2], t->root[d-1], t->root[d-2]);
+		t->level[d-2]++;
+		t->depth--;
+	}
+}
+
+/* treeleaf: finishes the current partial leaf and pushes its hash */
+static void treeleaf(SHATREE *t)
+{
+	shafinish(&t->leaf);
+	treepush(t, digcpy(&t->leaf));
+	t->leaflen = 0;
+}
+
+/* treereset: discards all data, keeping the tree's parameters */
+static void treereset(SHATREE *t)
+{
+	t->leaflen = 0;
+	t->depth = 0;
+}
+
+/* treeinit: initializes tree state; returns NULL on bad parameters */
+static SHATREE *treeinit(SHATREE *t, int alg, ULNG leafsize, int nthreads)
+{
+	Zero(t, 1, SHATREE);
+	if (!shainit(&t->result, alg))
+		return(NULL);
+	if (leafsize < SHA_TREE_MIN_LEAF || leafsize > SHA_TREE_MAX_LEAF ||
+		(leafsize & (leafsize - 1)))
+		return(NULL);
+	t->alg = alg;
+	t->leafsize = leafsize;
+	t->nthreads = nthreads < 1 ? shancpu() : nthreads;
+	treereset(t);
+	return(t);
+}
+
+/* treewrite: adds nbytes of data, hashing complete leaves in parallel */
+static void treewrite(SHATREE *t, UCHR *data, size_t nbytes)
+{
+	SHALEAVES l;
+	ULNG n;
+	int i, nleaves;
+
+	while (nbytes > 0) {
+		if (t->leaflen > 0 || nbytes < t->leafsize) {
+			if (t->leaflen == 0) {
+				shainit(&t->leaf, t->alg);
+				shawrite(leafprefix, 8, &t->leaf);
+			}
+			n = t->leafsize - t->leaflen;
+			if (n > nbytes)
+				n = (ULNG) nbytes;
+			shawritebytes(data, n, &t->leaf);
+			t->leaflen += n;
+			data += n;
+			nbytes -= n;
+			if (t->leaflen == t->leafsize)
+				treeleaf(t);
+			continue;
+		}
+		nleaves = nbytes / t->leafsize > SHA_TREE_BATCH ?
+			SHA_TREE_BATCH : (int) (nbytes / t->leafsize);
+		l.t = t;
+		l.data = data;
+		shaparallel(leaftask, &l, nleaves, t->nthreads);
+		for (i = 0; i < nleaves; i++)
+			treepush(t, t->batch[i]);
+		data += (size_t) nleaves * t->leafsize;
+		nbytes -= (size_t) nleaves * t->leafsize;
+	}
+}
+
+/* treefinish: computes the tree digest into t->result and resets */
+static void treefinish(SHATREE *t)
+{
+	UCHR digest[SHA_MAX_DIGEST_BITS/8];
+
+	if (t->leaflen > 0)
+		treeleaf(t);
+	if (t->depth == 0) {
+		shainit(&t->leaf, t->alg);
+		shawrite(leafprefix, 8, &t->leaf);
+		treeleaf(t);
+	}
+	Copy(t->root[--t->depth], digest, sizeof(digest), UCHR);
+	while (t->depth > 0) {
+		t->depth--;
+		treenode(t, t->root[t->depth], digest, digest);
+	}
+	shainit(&t->result, t->alg);
+	statecpy(&t->result, digest);
+	treereset(t);
+}
+
+#ifdef HAS_MMAP
+/* treereadfd: adds data read from fd until EOF; returns 1, or -1 */
+static int treereadfd(SHATREE *t, int fd)
+{
+	UCHR *buf;
+	ssize_t n;
+	int ret = 0, err;
+
+	if ((buf = (UCHR *) malloc(SHA_READ_SIZE)) == NULL) {
+		errno = ENOMEM;
+		return(-1);
+	}
+	while (ret == 0) {
+		if ((n = read(fd, buf, SHA_READ_SIZE)) > 0) {
+			SHA_STAT(&t->leaf, reads, 1);
+			SHA_STAT(&t->leaf, readbytes, n);
+			treewrite(t, buf, (size_t) n);
+		}
+		else if (n == 0)
+			ret = 1;
+		else if (errno != EINTR)
+			ret = -1;
+	}
+	err = errno;
+	free(buf);
+	errno = err;
+	return(ret);
+}
+#endif
+
+/*
+ * treemapfd: adds the contents of regular file fd, starting at offset
+ * pos, by mapping it in windows that end on leaf boundaries, so every
+ * leaf but the first can be hashed on a thread
+ *
+ * Returns 0 without touching the tree if the file can't be mapped,
+ * 1 on success, and -1 on a read error after data has been added.
+ */
+static int treemapfd(SHATREE *t, int fd, Off_t pos)
+{
+#ifdef HAS_MMAP
+	struct stat st;
+	Off_t off, base;
+	size_t len, skip;
+	ULNG nleaves, rem, want;
+	UCHR *map;
+	long pagesize = 4096;
+
+	if (fd < 0 || pos < 0 || fstat(fd, &st) != 0)
+		return(0);
+	if (!S_ISREG(st.st_mode) || pos >= st.st_size)
+		return(0);
+#if defined(HAS_SYSCONF) && defined(_SC_PAGESIZE)
+	if ((pagesize = sysconf(_SC_PAGESIZE)) <= 0)
+		pagesize = 4096;
+#endif
+	nleaves = SHA_MAP_WINDOW / t->leafsize;
+	if (nleaves > SHA_TREE_BATCH)
+		nleaves = SHA_TREE_BATCH;
+	if (nleaves < 1)
+		nleaves = 1;
+	for (off = pos; off < st.st_size; off += len) {
+
+		/* nleaves * leafsize is at most the larger of the window
+		 * and one leaf (<= SHA_TREE_MAX_LEAF), so want < 2^31 */
+
+		rem = (t->leafsize - t->leaflen) % t->leafsize;
+		want = rem + nleaves * t->leafsize;
+		if (want > SHA_MAP_WINDOW)
+			want = rem > 0 && rem < SHA_MAP_WINDOW ?
+				rem : SHA_MAP_WINDOW;
+		len = st.st_size - off < (Off_t) want ?
+			(size_t) (st.st_size - off) : (size_t) want;
+		base = off - off % pagesize;
+		skip = (size_t) (off - base);
+		map = (UCHR *) mmap(NULL, skip + len, PROT_READ, MAP_SHARED,
+			fd, base);
+		if (map == (UCHR *) MAP_FAILED) {
+			if (off == pos)
+				return(0);
+			if (lseek(fd, off, SEEK_SET) < 0)
+				return(-1);
+			return(treereadfd(t, fd));
+		}
+#if defined(HAS_MADVISE) && defined(MADV_WILLNEED)
+		madvise((Mmap_t) map, skip + len, MADV_WILLNEED);
+#endif
+		SHA_STAT(&t->leaf, reads, 1);
+		SHA_STAT(&t->leaf, readbytes, len);
+		treewrite(t, map + skip, len);
+		munmap((Mmap_t) map, skip + len);
+	}
+	return(1);
+#else
+	return(0);
+#endif
+}
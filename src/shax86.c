@@ -0,0 +1,255 @@
+/*
+ * shax86.c: x86 CPU detection, SHA-1/224/256 hardware transforms,
+ *           and vector hex/Base 64 encoders
+ *
+ * Ref: NIST FIPS PUB 180-4 Secure Hash Standard
+ *      Intel SHA Extensions (Gulley et al., July 2013)
+ *
+ * Copyright (C) 2003-2014 Mark Shelor, All Rights Reserved
+ *
+ */
+
+#define SHA_CPU_SSSE3	0x01		/* CPU feature flags */
+#define SHA_CPU_SSE41	0x02
+#define SHA_CPU_AVX2	0x04
+#define SHA_CPU_SHA	0x08
+#define SHA_CPU_BMI2	0x10
+
+#ifdef SHA_X86
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define CPUID1_ECX_SSSE3	(1 << 9)
+#define CPUID1_ECX_SSE41	(1 << 19)
+#define CPUID1_ECX_OSXSAVE	(1 << 27)
+#define CPUID1_ECX_AVX		(1 << 28)
+#define CPUID7_EBX_AVX2		(1 << 5)
+#define CPUID7_EBX_BMI2		(1 << 8)
+#define CPUID7_EBX_SHA		(1 << 29)
+
+/* xcr0: returns low word of XCR0 (OS-enabled register state) */
+static UINT xcr0(void)
+{
+	UINT eax, edx;
+
+	__asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0"	/* xgetbv */
+		: "=a" (eax), "=d" (edx) : "c" (0));
+	return(eax);
+}
+
+/* shacycles: returns the CPU's time-stamp counter (for benchmarks) */
+static double shacycles(void)
+{
+	UINT lo, hi;
+
+	__asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+	return((double) hi * 4294967296.0 + (double) lo);
+}
+
+/* shacpuid: returns available CPU features as SHA_CPU_* flags */
+static int shacpuid(void)
+{
+	UINT eax, ebx, ecx, edx, max;
+	int avx = 0;
+	int features = 0;
+
+	if (!__get_cpuid(0, &max, &ebx, &ecx, &edx) || max < 1)
+		return(0);
+	__cpuid(1, eax, ebx, ecx, edx);
+	if (ecx & CPUID1_ECX_SSSE3)
+		features |= SHA_CPU_SSSE3;
+	if (ecx & CPUID1_ECX_SSE41)
+		features |= SHA_CPU_SSE41;
+	if ((ecx & CPUID1_ECX_OSXSAVE) && (ecx & CPUID1_ECX_AVX))
+		avx = (xcr0() & 0x06) == 0x06;
+	if (max < 7)
+		return(features);
+	__cpuid_count(7, 0, eax, ebx, ecx, edx);
+	if ((ebx & CPUID7_EBX_AVX2) && avx)
+		features |= SHA_CPU_AVX2;
+	if (ebx & CPUID7_EBX_SHA)
+		features |= SHA_CPU_SHA;
+	if (ebx & CPUID7_EBX_BMI2)
+		features |= SHA_CPU_BMI2;
+	return(features);
+}
+
+/*
+ * SHA-1 transform using SHA-NI
+ *
+ * Each step performs four rounds with sha1rnds4, while the message
+ * schedule for later steps is computed in parallel.  As in sha1(),
+ * the roles of the registers rotate from step to step, so one macro
+ * covers all twenty steps; the conditions fold at compile time.
+ */
+
+#define NI1(i, ea, eb, m0, m1, m2, m3)					\
+	if ((i) > 0) ea = _mm_sha1nexte_epu32(ea, m0);			\
+	eb = abcd;							\
+	if ((i) >= 3 && (i) <= 18) m1 = _mm_sha1msg2_epu32(m1, m0);	\
+	abcd = _mm_sha1rnds4_epu32(abcd, ea, (i) / 5);			\
+	if ((i) >= 1 && (i) <= 16) m3 = _mm_sha1msg1_epu32(m3, m0);	\
+	if ((i) >= 2 && (i) <= 17) m2 = _mm_xor_si128(m2, m0)
+
+static void SHA_TARGET("sha,ssse3,sse4.1") sha1ni(SHA *s, UCHR *block)
+{
+	__m128i abcd, abcd0, e0, e1, e00;
+	__m128i m0, m1, m2, m3;
+	const __m128i bswap = _mm_set_epi64x(
+		0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+	W32 *H = s->H.H32;
+
+	abcd = _mm_shuffle_epi32(_mm_loadu_si128((__m128i *) H), 0x1b);
+	e0 = _mm_set_epi32((int) H[4], 0, 0, 0);
+	abcd0 = abcd; e00 = e0;
+
+	m0 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *) block), bswap);
+	m1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *) (block+16)), bswap);
+	m2 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *) (block+32)), bswap);
+	m3 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *) (block+48)), bswap);
+	e0 = _mm_add_epi32(e0, m0);
+
+	NI1( 0, e0, e1, m0, m1, m2, m3); NI1( 1, e1, e0, m1, m2, m3, m0);
+	NI1( 2, e0, e1, m2, m3, m0, m1); NI1( 3, e1, e0, m3, m0, m1, m2);
+	NI1( 4, e0, e1, m0, m1, m2, m3); NI1( 5, e1, e0, m1, m2, m3, m0);
+	NI1( 6, e0, e1, m2, m3, m0, m1); NI1( 7, e1, e0, m3, m0, m1, m2);
+	NI1( 8, e0, e1, m0, m1, m2, m3); NI1( 9, e1, e0, m1, m2, m3, m0);
+	NI1(10, e0, e1, m2, m3, m0, m1); NI1(11, e1, e0, m3, m0, m1, m2);
+	NI1(12, e0, e1, m0, m1, m2, m3); NI1(13, e1, e0, m1, m2, m3, m0);
+	NI1(14, e0, e1, m2, m3, m0, m1); NI1(15, e1, e0, m3, m0, m1, m2);
+	NI1(16, e0, e1, m0, m1, m2, m3); NI1(17, e1, e0, m1, m2, m3, m0);
+	NI1(18, e0, e1, m2, m3, m0, m1); NI1(19, e1, e0, m3, m0, m1, m2);
+
+	e0 = _mm_sha1nexte_epu32(e0, e00);
+	abcd = _mm_shuffle_epi32(_mm_add_epi32(abcd, abcd0), 0x1b);
+	_mm_storeu_si128((__m128i *) H, abcd);
+	H[4] = (W32) _mm_extract_epi32(e0, 3);
+}
+
+/*
+ * SHA-224/256 transform using SHA-NI
+ *
+ * The state is kept as ABEF/CDGH register pairs, which is the layout
+ * expected by sha256rnds2.  Message words are scheduled four at a
+ * time with sha256msg1/sha256msg2 (ref. Intel white paper).
+ */
+
+#define NI2(i, m0, m1, m2, m3)						\
+	msg = _mm_add_epi32(m0, _mm_loadu_si128((__m128i *) (K256+4*(i))));\
+	cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);			\
+	if ((i) >= 3 && (i) <= 14) {					\
+		m1 = _mm_add_epi32(m1, _mm_alignr_epi8(m0, m3, 4));	\
+		m1 = _mm_sha256msg2_epu32(m1, m0);			\
+	}								\
+	msg = _mm_shuffle_epi32(msg, 0x0e);				\
+	abef = _mm_sha256rnds2_epu32(abef, cdgh, msg);			\
+	if ((i) >= 1 && (i) <= 12) m3 = _mm_sha256msg1_epu32(m3, m0)
+
+static void SHA_TARGET("sha,ssse3,sse4.1") sha256ni(SHA *s, UCHR *block)
+{
+	__m128i abef, cdgh, abef0, cdgh0, msg, tmp;
+	__m128i m0, m1, m2, m3;
+	const __m128i bswap = _mm_set_epi64x(
+		0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+	W32 *H = s->H.H32;
+
+	tmp  = _mm_shuffle_epi32(_mm_loadu_si128((__m128i *) H), 0xb1);
+	cdgh = _mm_shuffle_epi32(_mm_loadu_si128((__m128i *) (H+4)), 0x1b);
+	abef = _mm_alignr_epi8(tmp, cdgh, 8);
+	cdgh = _mm_blend_epi16(cdgh, tmp, 0xf0);
+	abef0 = abef; cdgh0 = cdgh;
+
+	m0 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *) block), bswap);
+	m1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *) (block+16)), bswap);
+	m2 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *) (block+32)), bswap);
+	m3 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *) (block+48)), bswap);
+
+	NI2( 0, m0, m1, m2, m3); NI2( 1, m1, m2, m3, m0);
+	NI2( 2, m2, m3, m0, m1); NI2( 3, m3, m0, m1, m2);
+	NI2( 4, m0, m1, m2, m3); NI2( 5, m1, m2, m3, m0);
+	NI2( 6, m2, m3, m0, m1); NI2( 7, m3, m0, m1, m2);
+	NI2( 8, m0, m1, m2, m3); NI2( 9, m1, m2, m3, m0);
+	NI2(10, m2, m3, m0, m1); NI2(11, m3, m0, m1, m2);
+	NI2(12, m0, m1, m2, m3); NI2(13, m1, m2, m3, m0);
+	NI2(14, m2, m3, m0, m1); NI2(15, m3, m0, m1, m2);
+
+	abef = _mm_add_epi32(abef, abef0);
+	cdgh = _mm_add_epi32(cdgh, cdgh0);
+	tmp  = _mm_shuffle_epi32(abef, 0x1b);
+	cdgh = _mm_shuffle_epi32(cdgh, 0xb1);
+	_mm_storeu_si128((__m128i *) H, _mm_blend_epi16(tmp, cdgh, 0xf0));
+	_mm_storeu_si128((__m128i *) (H+4), _mm_alignr_epi8(cdgh, tmp, 8));
+}
+
+SHA_UPDATE(SHA_TARGET("sha,ssse3,sse4.1"), sha1niup, sha1ni, 64)
+SHA_UPDATE(SHA_TARGET("sha,ssse3,sse4.1"), sha256niup, sha256ni, 64)
+
+/*
+ * hexssse3: hex-encodes in, 16 bytes at a time, into out; returns the
+ * number of bytes encoded (the caller encodes the rest)
+ */
+static UINT SHA_TARGET("ssse3") hexssse3(UCHR *in, UINT n, char *out)
+{
+	UINT i;
+	__m128i v, hi, lo;
+	__m128i lut = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+		'8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+	__m128i mask = _mm_set1_epi8(0x0f);
+
+	for (i = 0; i + 16 <= n; i += 16) {
+		v = _mm_loadu_si128((__m128i *) (in + i));
+		hi = _mm_shuffle_epi8(lut,
+			_mm_and_si128(_mm_srli_epi16(v, 4), mask));
+		lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, mask));
+		_mm_storeu_si128((__m128i *) (out + 2*i),
+			_mm_unpacklo_epi8(hi, lo));
+		_mm_storeu_si128((__m128i *) (out + 2*i + 16),
+			_mm_unpackhi_epi8(hi, lo));
+	}
+	return(i);
+}
+
+/*
+ * b64ssse3: Base 64-encodes in, 12 bytes at a time, into out, using
+ * the URL-safe alphabet if url is set; returns the number of bytes
+ * encoded (always a multiple of 3)
+ *
+ * Each step loads 16 bytes, so it stops while 16 remain to be read.
+ * Ref: W. Mula, "Base64 encoding with SIMD instructions" (2016)
+ */
+static UINT SHA_TARGET("ssse3") b64ssse3(UCHR *in, UINT n, char *out,
+	int url)
+{
+	UINT i;
+	__m128i v, t0, t1, idx, r;
+	__m128i spread = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4,
+		7, 6, 8, 7, 10, 9, 11, 10);
+	__m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52,
+		'0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+		'0' - 52, '0' - 52, url ? '-' - 62 : '+' - 62,
+		url ? '_' - 63 : '/' - 63, 'A', 0, 0);
+
+	for (i = 0; i + 16 <= n; i += 12, out += 16) {
+		v = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *) (in + i)),
+			spread);
+		t0 = _mm_mulhi_epu16(_mm_and_si128(v,
+			_mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+		t1 = _mm_mullo_epi16(_mm_and_si128(v,
+			_mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+		idx = _mm_or_si128(t0, t1);
+		r = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+		r = _mm_or_si128(r, _mm_and_si128(_mm_cmpgt_epi8(
+			_mm_set1_epi8(26), idx), _mm_set1_epi8(13)));
+		r = _mm_add_epi8(_mm_shuffle_epi8(shift, r), idx);
+		_mm_storeu_si128((__m128i *) out, r);
+	}
+	return(i);
+}
+
+#else
+
+#define shacpuid()	0
+#define shacycles()	0.0
+
+#endif	/* #ifdef SHA_X86 */
@@ -0,0 +1,78 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw(sha256_hex));
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# Files of various sizes, including sizes around page and
+	# block boundaries, must digest the same as their contents,
+	# whether they're mapped, pipelined, or read in the usual way
+
+my @sizes = (0, 1, 63, 64, 4095, 4096, 4097, 65537, 300000);
+my @modes = ("b", "U", "p", "");
+
+my @opts = (undef, { pipeline => 1 },
+	{ pipeline => 1, buffers => 2, bufsize => 4096 });
+
+my $numtests = scalar(@sizes) + 2;
+print "1..$numtests\n";
+
+my $tempfile = "addfile.tmp";
+END { 1 while unlink $tempfile }
+
+sub writefile {
+	my $data = shift;
+	local *F;
+	open(F, "> $tempfile") or die $!;
+	binmode(F);
+	print F $data;
+	close(F);
+}
+
+my $testnum = 1;
+for my $size (@sizes) {
+	my $data = join('', map { chr(($_ * 17 + 5) % 256) } (1 .. $size));
+	writefile($data);
+	my $rsp = sha256_hex($data);
+	my $ok = 1;
+	for my $mode ($size ? ("b", "U", "p") : @modes) {
+		for my $opts (@opts) {
+			my $digest = $MODULE->new(256)->
+				addfile($tempfile, $mode, $opts);
+			$ok = 0 unless $digest->hexdigest eq $rsp;
+		}
+	}
+	print "not " unless $ok;
+	print "ok ", $testnum++, "\n";
+}
+
+	# appending a file to a state that's already in use
+
+my $data = "\0\1\2" x 50000;
+writefile($data);
+my $state = $MODULE->new(256)->add("abc");
+print "not " unless $state->addfile($tempfile, "b")->hexdigest eq
+	sha256_hex("abc" . $data);
+print "ok ", $testnum++, "\n";
+
+	# open file handles are read from their current position
+
+local *FH;
+open(FH, "< $tempfile") or die $!;
+binmode(FH);
+read(FH, my $buf, 10000);
+print "not " unless $MODULE->new(256)->addfile(*FH)->hexdigest eq
+	sha256_hex(substr($data, 10000));
+print "ok ", $testnum++, "\n";
+close(FH);
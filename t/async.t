@@ -0,0 +1,136 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw());
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# Files hashed in the background must digest as they would in
+	# the foreground, whether named or given as open handles
+
+my $numtests = 8;
+print "1..$numtests\n";
+
+my $testnum = 1;
+
+unless ($MODULE eq "Digest::SHA") {
+	print "ok ", $testnum++, " # skip: no addfile_async\n"
+		for 1 .. $numtests;
+	exit;
+}
+
+my @files = map { "async$_.tmp" } 1 .. 12;
+END { unlink @files }
+
+for my $i (0 .. $#files) {
+	local *F;
+	open(F, "> $files[$i]") or die $!;
+	binmode(F);
+	print F join("", map { chr(($_ * 7 + $i) % 256) } 1 .. 5000 * $i);
+	close(F);
+}
+
+	# without threads, jobs run (and call back) before returning
+
+my $threads = defined Digest::SHA::async_fd();
+print "not " unless Digest::SHA::async_threads(3) == ($threads ? 3 : 1);
+print "ok ", $testnum++, "\n";
+
+	# each interpreter collects only its own jobs (the thread starts
+	# before any objects exist, since objects can't be cloned)
+
+my $ithreads = eval { require Config; $Config::Config{useithreads} &&
+	$threads && require threads };
+if (!$ithreads) {
+	print "ok ", $testnum++, " # skip: no ithreads\n";
+}
+else {
+	my $mine = 0;
+	my $thr = threads->create(sub {
+		my $theirs = 0;
+		$MODULE->new(256)->addfile_async($_, sub { $theirs++ })
+			for @files;
+		my $n = Digest::SHA::async_wait();
+		$n == @files && $theirs == @files ? 1 : 0;
+	});
+	$MODULE->new(256)->addfile_async($_, sub { $mine++ }) for @files;
+	my $ok = $thr->join;
+	print "not " unless $ok && Digest::SHA::async_wait() == @files &&
+		$mine == @files;
+	print "ok ", $testnum++, "\n";
+}
+
+	# many jobs share the pool, and each callback gets its object
+
+my %got;
+for my $file (@files) {
+	my $sha = $MODULE->new(256)->add("prefix");
+	$sha->addfile_async($file, sub {
+		my ($s, $err) = @_;
+		$got{$file} = $s && $s == $sha ? $s->hexdigest : "error";
+	}) or die "addfile_async: $!";
+}
+print "not " unless Digest::SHA::async_wait() == ($threads ? @files : 0) &&
+	keys(%got) == @files && Digest::SHA::async_pending() == 0;
+print "ok ", $testnum++, "\n";
+
+my $same = grep { $got{$_} eq $MODULE->new(256)->add("prefix")->
+	addfile($_, "b")->hexdigest } @files;
+print "not " unless $same == @files;
+print "ok ", $testnum++, "\n";
+
+	# handles are read from their current position
+
+local *FH;
+open(FH, "< $files[5]") or die $!;
+binmode(FH);
+my $rest = do { local $/; <FH> };
+seek(FH, 1000, 0);
+my $digest;
+$MODULE->new(1)->addfile_async(*FH, sub { $digest = $_[0]->hexdigest });
+Digest::SHA::async_wait();
+close(FH);
+print "not " unless defined $digest &&
+	$digest eq $MODULE->new(1)->add(substr($rest, 1000))->hexdigest;
+print "ok ", $testnum++, "\n";
+
+	# errors are reported to the callback, leaving the object alone
+
+my($obj, $err);
+my $sha = $MODULE->new(1)->add("abc");
+$sha->addfile_async("no/such/file.tmp", sub { ($obj, $err) = @_ });
+Digest::SHA::async_wait();
+print "not " unless !defined $obj && $err &&
+	$sha->hexdigest eq $MODULE->new(1)->add("abc")->hexdigest;
+print "ok ", $testnum++, "\n";
+
+	# the completion pipe becomes readable when a job finishes
+
+my $fd = Digest::SHA::async_fd();
+if (!defined $fd) {
+	print "ok ", $testnum++, " # skip: no threads\n";
+}
+else {
+	$MODULE->new(1)->addfile_async($files[-1]);
+	my $rin = "";
+	vec($rin, $fd, 1) = 1;
+	my $ready = select(my $rout = $rin, undef, undef, 30);
+	print "not " unless $ready == 1 && Digest::SHA::async_poll() == 1;
+	print "ok ", $testnum++, "\n";
+}
+
+	# ids that weren't handed out here are refused, not dereferenced
+
+print "not " if defined Digest::SHA::_async_finish(undef, 12345) ||
+	defined Digest::SHA::_async_finish(undef, 0);
+print "ok ", $testnum++, "\n";
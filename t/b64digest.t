@@ -0,0 +1,66 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw());
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# Base 64 digests with the URL-safe alphabet and/or padding
+
+my @vec = (
+	[1, {}, "qZk+NkcGgWq6PiVxeFDCbJzQ2J0"],
+	[1, {pad => 1}, "qZk+NkcGgWq6PiVxeFDCbJzQ2J0="],
+	[1, {url => 1}, "qZk-NkcGgWq6PiVxeFDCbJzQ2J0"],
+	[256, {url => 1, pad => 1},
+		"ungWv48Bz-pBQUDeXa4iI7ADYaOWF3qctBD_YfIAFa0="],
+	[256, {url => 0, pad => 0},
+		"ungWv48Bz+pBQUDeXa4iI7ADYaOWF3qctBD/YfIAFa0"],
+	[512, {url => 1, pad => 1},
+		"3a81oZNherrMQXNJriBBMRLm-k6JqX6iCp7u5ktV05ohkpkqJ0_BqDa6PCOj_uu9RU1EI2Q86A4qmslPpUyknw=="],
+);
+
+my $numtests = @vec + 2;
+print "1..$numtests\n";
+
+my $testnum = 1;
+
+unless ($MODULE eq "Digest::SHA") {
+	print "ok ", $testnum++, " # skip: no b64digest options\n"
+		for 1 .. $numtests;
+	exit;
+}
+
+for my $vec (@vec) {
+	my ($alg, $opts, $b64) = @$vec;
+	my $state = $MODULE->new($alg) or do {
+		print "ok ", $testnum++, " # skip: no 64-bit\n";
+		next;
+	};
+	print "not " unless
+		$state->add("abc")->b64digest(%$opts) eq $b64;
+	print "ok ", $testnum++, "\n";
+}
+
+my $state = $MODULE->new(1)->add("abc");
+print "not " if defined $state->b64digest(bogus => 1);
+print "ok ", $testnum++, "\n";
+
+	# options belong to b64digest alone, and must come in pairs;
+	# refusing them leaves the state alone
+
+my $ok = !defined $state->hexdigest(url => 1) &&
+	!defined $state->digest(pad => 1) &&
+	!defined $state->b64digest("url");
+print "not " unless $ok && $state->hexdigest eq
+	"a9993e364706816aba3e25717850c26c9cd0d89d";
+print "ok ", $testnum++, "\n";
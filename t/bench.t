@@ -0,0 +1,59 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw());
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# A short benchmark run produces one well-formed row per measurement
+
+my $numtests = 6;
+print "1..$numtests\n";
+
+my $testnum = 1;
+
+unless ($MODULE eq "Digest::SHA") {
+	print "ok ", $testnum++, " # skip: no Digest::SHA::Bench\n"
+		for 1 .. $numtests;
+	exit;
+}
+
+require Digest::SHA::Bench;
+
+my @tests = qw(oneshot add hmac addfile hex base64);
+my @r = Digest::SHA::Bench::run(algs => [1, 256], sizes => [0, 100],
+	tests => \@tests, mintime => 0.001);
+
+print "not " unless @r == 2 * 2 * @tests;
+print "ok ", $testnum++, "\n";
+
+print "not " if grep { $_->{iters} < 1 || $_->{ns_per_op} !~ /^\d+\.\d$/ }
+	@r;
+print "ok ", $testnum++, "\n";
+
+print "not " if grep { defined $_->{mb_per_s} != ($_->{bytes} > 0) } @r;
+print "ok ", $testnum++, "\n";
+
+my @lines = Digest::SHA::Bench::header();
+my @cols = split(/\t/, pop @lines);
+print "not " if grep { !/^# / } @lines or $cols[0] ne 'test';
+print "ok ", $testnum++, "\n";
+
+my @f = split(/\t/, Digest::SHA::Bench::row($r[0]));
+print "not " unless @f == @cols && $f[0] eq 'oneshot' && $f[6] eq '-';
+print "ok ", $testnum++, "\n";
+
+print "not " unless Digest::SHA::Bench::size("16M") == 1 << 24 &&
+	Digest::SHA::Bench::size("4k") == 4096 &&
+	!defined Digest::SHA::Bench::size("lots");
+print "ok ", $testnum++, "\n";
@@ -15,7 +15,7 @@ BEGIN {
 	}
 }
 
-my $numtests = 4;
+my $numtests = 5;
 print "1..$numtests\n";
 
 	# Here's the bitstring to test against, and its SHA-1 digest
@@ -70,4 +70,26 @@ while ($reps > $maxbits) {
 $state->add_bits($ONEBITS, $reps);
 
 print "not " unless $state->hexdigest eq $digest;
+print "ok ", $testnum++, "\n";
+
+	# feed varied data at every bit alignment, checking against one
+	# aligned write of the same bitstring
+
+my $bits = join("", map { sprintf("%08b", ($_ * 167 + 13) % 256) } 1 .. 700);
+my $ok = 1;
+
+for my $alg (1, 256, 512) {
+	next unless $MODULE->new($alg);		# no 64-bit
+	for my $skew (1 .. 7) {
+		my $ref = $MODULE->new($alg)->add_bits($bits)->hexdigest;
+		$state = $MODULE->new($alg);
+		$state->add_bits(substr($bits, 0, $skew));
+		for (my $i = $skew; $i < length($bits); $i += 1001) {
+			$state->add_bits(substr($bits, $i, 1001));
+		}
+		$ok = 0 unless $state->hexdigest eq $ref;
+	}
+}
+
+print "not " unless $ok;
 print "ok ", $testnum++, "\n";
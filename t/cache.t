@@ -0,0 +1,111 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw(sha256_hex));
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# The digest cache must supply states for unchanged files, and
+	# must never supply them for files that changed since
+
+my $numtests = 10;
+print "1..$numtests\n";
+
+my $cachefile = "cache.tmp";
+my $datafile = "cachedata.tmp";
+END { 1 while unlink $cachefile; 1 while unlink $datafile }
+
+my $cache;
+$cache = Digest::SHA::Cache->new($cachefile)
+	if $MODULE eq "Digest::SHA" && eval { require Digest::SHA::Cache };
+unless ($cache) {
+	print "ok $_ # skip: digest cache not available\n" for (1 .. $numtests);
+	exit;
+}
+print "ok 1\n";
+
+sub writefile {
+	my ($file, $data) = @_;
+	local *F;
+	open(F, "> $file") or die $!;
+	binmode(F);
+	print F $data;
+	close(F);
+}
+
+writefile($datafile, "not a cache file\n");
+my $bad = defined Digest::SHA::Cache->new($datafile);
+writefile($datafile, "\0" x 4 . "binary data" x 20);
+$bad ||= defined Digest::SHA::Cache->new($datafile);
+print "not " if $bad || -s $datafile != 224;
+print "ok 2\n";
+
+print "not " unless defined $cache->key($datafile) && !defined $cache->key(".");
+print "ok 3\n";
+
+	# files changed in the last couple of seconds aren't cached,
+	# unless the cache is told otherwise
+
+my $data = "abc" x 100000;
+writefile($datafile, $data);
+my $state = $MODULE->new(256)->add($data)->_getstate;
+print "not " if $cache->put($cache->key($datafile), 256, "b", $state);
+print "ok 4\n";
+$cache = Digest::SHA::Cache->new($cachefile, racy => 0);
+
+my $digest = $MODULE->new(256)->addfile($datafile, "b", { cache => $cache });
+print "not " unless $digest->hexdigest eq sha256_hex($data) &&
+	$cache->get($cache->key($datafile), 256, "b") eq $state;
+print "ok 5\n";
+
+	# a cached state is used in place of reading the file
+
+my $bogus = $MODULE->new(256)->add("bogus")->_getstate;
+$cache->put($cache->key($datafile), 256, "b", $bogus);
+my $d1 = $MODULE->new(256)->addfile($datafile, "b", { cache => $cache });
+my $d2 = Digest::SHA::digest_files(256, [$datafile], { cache => $cache });
+print "not " unless $d1->hexdigest eq sha256_hex("bogus") &&
+	$d2->{$datafile} eq sha256_hex("bogus");
+print "ok 6\n";
+
+	# ... but not after the file changes, or for other algorithms
+	# or modes, or once data has been added
+
+my $ok = $MODULE->new(1)->addfile($datafile, "b", { cache => $cache })
+		->hexdigest ne Digest::SHA->new(1)->add("bogus")->hexdigest &&
+	$MODULE->new(256)->addfile($datafile, "U", { cache => $cache })
+		->hexdigest eq sha256_hex($data) &&
+	$MODULE->new(256)->add("x")->addfile($datafile, "b",
+		{ cache => $cache })->hexdigest eq sha256_hex("x" . $data);
+writefile($datafile, $data . "d");
+$ok &&= $MODULE->new(256)->addfile($datafile, "b", { cache => $cache })
+	->hexdigest eq sha256_hex($data . "d");
+print "not " unless $ok;
+print "ok 7\n";
+
+	# the table grows past its initial size, across processes
+
+my @keys = map { pack("N13", 0, 1, 0, $_, 0, 9, 0, 1000, 0, 0, 1000, 0, 0) }
+	(1 .. 3000);
+$cache->put($_, 1, "b", $_) for @keys;
+my $other = Digest::SHA::Cache->new($cachefile);
+print "not " unless 3000 == grep { $other->get($_, 1, "b") eq $_ } @keys;
+print "ok 8\n";
+
+print "not " if defined $cache->get($keys[0], 256, "b") ||
+	defined $cache->get($keys[0], 1, "U");
+print "ok 9\n";
+
+$other = Digest::SHA::Cache->new($cachefile, rebuild => 1);
+print "not " if grep { defined $cache->get($_, 1, "b") } @keys;
+print "ok 10\n";
@@ -0,0 +1,140 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw(sha1 sha256 sha256_hex));
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# Chunks must agree with a direct implementation of the boundary
+	# rules, cover the stream contiguously, carry the digest of their
+	# bytes, and not depend on how the data is split between calls
+
+my @gear = map { unpack("N", sha256(chr($_))) } (0 .. 255);
+
+sub refchunks {
+	my($data, $min, $avg, $max) = @_;
+	my $bits = 0;
+	$bits++ while (1 << $bits) < $avg;
+	my $masks = 0xffffffff ^ (0xffffffff >> ($bits + 2));
+	my $maskl = 0xffffffff ^ (0xffffffff >> ($bits - 2));
+	my($off, $n, @chunks) = (0, length($data));
+	while ($off < $n) {
+		my($i, $fp) = ($off + $min, 0);
+		while ($i < $n && $i - $off < $max) {
+			$fp = (($fp << 1) + $gear[ord(substr($data, $i++, 1))])
+				& 0xffffffff;
+			last unless $fp & ($i - $off <= $avg ? $masks : $maskl);
+		}
+		$i = $n if $i > $n;
+		push(@chunks, [$off, $i - $off]);
+		$off = $i;
+	}
+	return(@chunks);
+}
+
+sub same {
+	my($x, $y) = @_;
+	join(",", map { "@$_" } @$x) eq join(",", map { "@$_" } @$y);
+}
+
+srand(1);
+my $data = join('', map { chr(int(rand(256))) } (1 .. 200000));
+
+my @params = ([2048, 8192, 65536], [64, 256, 1000], [1000, 4096, 5000]);
+
+my $numtests = 2 * scalar(@params) + 6;
+print "1..$numtests\n";
+
+unless ($MODULE eq "Digest::SHA" && eval { require Digest::SHA::CDC }) {
+	print "ok $_ # skip: Digest::SHA::CDC not available\n"
+		for (1 .. $numtests);
+	exit;
+}
+
+my $testnum = 1;
+for my $p (@params) {
+	my($min, $avg, $max) = @$p;
+	my $cdc = Digest::SHA::CDC->new(256, min => $min, avg => $avg,
+		max => $max, format => "hex");
+	my @chunks = ($cdc->add($data), $cdc->finish);
+	my @rsp = refchunks($data, $min, $avg, $max);
+	my $ok = @chunks == @rsp;
+	for my $i (0 .. $#rsp) {
+		my($off, $len) = @{$rsp[$i]};
+		$ok = 0 unless $chunks[$i]->[0] == $off &&
+			$chunks[$i]->[1] == $len && $chunks[$i]->[2] eq
+				sha256_hex(substr($data, $off, $len));
+	}
+	print "not " unless $ok;
+	print "ok ", $testnum++, "\n";
+
+	my @pieces;
+	push(@pieces, $cdc->add($_)) for unpack("(a777)*", $data);
+	push(@pieces, $cdc->add(""), $cdc->finish);
+	print "not " unless same(\@chunks, \@pieces);
+	print "ok ", $testnum++, "\n";
+}
+
+	# the default parameters, binary digests, and boundaries that
+	# are fixed by the format (ref. CHUNK BOUNDARIES in the POD)
+
+my $cdc = Digest::SHA::CDC->new("sha1");
+my @chunks = ($cdc->add($data), $cdc->finish);
+print "not " unless $cdc->min_size == 2048 && $cdc->avg_size == 8192 &&
+	$cdc->max_size == 65536 && $cdc->hashsize == 160 &&
+	$chunks[0]->[2] eq sha1(substr($data, 0, $chunks[0]->[1]));
+print "ok ", $testnum++, "\n";
+
+my $small = Digest::SHA::CDC->new(256, min => 64, avg => 256, max => 1024);
+my $periodic = join('', map { chr(($_ * 7) % 251) } (1 .. 4096));
+my @lens = map { $_->[1] }
+	($small->add("\0" x 4096), $small->add($periodic), $small->finish);
+print "not " unless "@lens" eq "1024 1024 1024 1024 73 272 346 389 269 " .
+	"346 389 269 346 389 269 346 389 4";
+print "ok ", $testnum++, "\n";
+
+	# an insertion near the start leaves the later chunks unchanged
+
+my %seen = map { $_->[2] => 1 } @chunks;
+my @shifted = ($cdc->add("inserted" . $data), $cdc->finish);
+my $shared = grep { $seen{$_->[2]} } @shifted;
+print "not " unless $shared >= @chunks - 2;
+print "ok ", $testnum++, "\n";
+
+	# an empty stream has no chunks, and reset discards data
+
+print "not " if $cdc->finish || $cdc->add("x" x 100);
+$cdc->reset;
+print "not " if $cdc->finish;
+print "ok ", $testnum++, "\n";
+
+	# addfile reads raw bytes, with offsets continuing across calls
+
+my $tempfile = "cdc.tmp";
+END { 1 while unlink $tempfile }
+open(my $fh, "> $tempfile") or die $!;
+binmode($fh);
+print $fh $data;
+close($fh);
+my @fromfile = ($cdc->addfile($tempfile), $cdc->finish);
+print "not " unless same(\@chunks, \@fromfile);
+print "ok ", $testnum++, "\n";
+
+	# bad parameters are refused
+
+print "not " if defined Digest::SHA::CDC->new(256, avg => 5000) ||
+	defined Digest::SHA::CDC->new(256, min => 8192) ||
+	defined Digest::SHA::CDC->new(256, max => 8192) ||
+	defined Digest::SHA::CDC->new(256, format => "octal") ||
+	defined Digest::SHA::CDC->new(257);
+print "ok ", $testnum++, "\n";
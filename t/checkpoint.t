@@ -0,0 +1,109 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw());
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# Binary checkpoints, singly and in slab files
+
+my @algs = (1, 224, 256, 384, 512, 512224, 512256);
+my $numtests = @algs + 7;
+print "1..$numtests\n";
+
+my $testnum = 1;
+
+unless ($MODULE eq "Digest::SHA") {
+	print "ok ", $testnum++, " # skip: no checkpoints\n"
+		for 1 .. $numtests;
+	exit;
+}
+
+	# resuming a checkpoint continues the digest where it left off
+
+my $data = join("", map { chr } 0 .. 255) x 3;
+for my $alg (@algs) {
+	my $sha = $MODULE->new($alg) or do {
+		print "ok ", $testnum++, " # skip: no 64-bit\n";
+		next;
+	};
+	$sha->add(substr($data, 0, 301));
+	$sha->add_bits("101");
+	my $ckpt = $sha->checkpoint;
+	my $copy = $MODULE->resume($ckpt);
+	print "not " unless length($ckpt) == 256 && $copy &&
+		$copy->algorithm == $alg &&
+		$copy->add($data)->hexdigest eq $sha->add($data)->hexdigest;
+	print "ok ", $testnum++, "\n";
+}
+
+my $sha = $MODULE->new(256)->add("abc");
+my $ckpt = $sha->checkpoint;
+
+	# any damage is detected, and leaves the object alone
+
+my $bad = 0;
+for my $i (0, 4, 8, 16, 100, 251, 255) {
+	my $c = $ckpt;
+	substr($c, $i, 1) ^= "\x01";
+	$bad++ unless defined $MODULE->resume($c);
+}
+print "not " unless $bad == 7 && !defined $MODULE->resume(substr($ckpt, 1));
+print "ok ", $testnum++, "\n";
+
+my $other = $MODULE->new(1)->add("xyz");
+print "not " unless !defined $other->resume("x" x 256) &&
+	$other->clone->hexdigest eq $MODULE->new(1)->add("xyz")->hexdigest;
+print "ok ", $testnum++, "\n";
+
+	# as an instance method, resume takes the algorithm from $ckpt
+
+print "not " unless $other->resume($ckpt) && $other->algorithm == 256 &&
+	$other->hexdigest eq $sha->clone->hexdigest;
+print "ok ", $testnum++, "\n";
+
+	# slab files keep states in order
+
+my $file = "ckpt.tmp";
+my @states = map { $MODULE->new(256)->add("message $_") } 1 .. 50;
+print "not " unless Digest::SHA::save_states($file, @states) == 50;
+print "ok ", $testnum++, "\n";
+
+my @loaded = Digest::SHA::load_states($file);
+my $same = grep { $loaded[$_] && $loaded[$_]->hexdigest eq
+	$states[$_]->clone->hexdigest } 0 .. $#states;
+print "not " unless @loaded == 50 && $same == 50;
+print "ok ", $testnum++, "\n";
+
+	# a damaged record loads as undef; a damaged header loads nothing
+
+open(my $fh, "+< $file") or die "can't open $file: $!";
+binmode($fh);
+seek($fh, 64 + 256 * 7 + 40, 0);
+print $fh "\xff";
+close($fh);
+@loaded = Digest::SHA::load_states($file);
+print "not " unless @loaded == 50 && !defined $loaded[7] &&
+	(grep { defined } @loaded) == 49;
+print "ok ", $testnum++, "\n";
+
+open($fh, "+< $file") or die "can't open $file: $!";
+binmode($fh);
+seek($fh, 12, 0);
+print $fh "\0\0\0\x33";
+close($fh);
+@loaded = Digest::SHA::load_states($file);
+unlink($file);
+print "not " unless @loaded == 0 && !defined
+	Digest::SHA::save_states($file, $sha, "not an object");
+print "ok ", $testnum++, "\n";
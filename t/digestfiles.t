@@ -0,0 +1,78 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw(sha1_hex sha256_hex sha256_base64 sha512));
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# Batch digests of files, with and without worker threads,
+	# must match digests of the file contents; unreadable files
+	# are reported individually
+
+my $numtests = 7;
+print "1..$numtests\n";
+
+unless ($MODULE->can("digest_files")) {
+	print "ok $_ # skip: digest_files not available\n" for (1 .. $numtests);
+	exit;
+}
+
+my @data = map { join('', map { chr(($_ * 13 + 1) % 256) } (1 .. $_)) }
+	(0, 1, 64, 1000, 65537, 200003);
+my @files = map { "digfile$_.tmp" } (0 .. $#data);
+END { for my $f (@files) { 1 while unlink $f } }
+
+for my $i (0 .. $#data) {
+	local *F;
+	open(F, "> $files[$i]") or die $!;
+	binmode(F);
+	print F $data[$i];
+	close(F);
+}
+
+my $testnum = 1;
+for my $jobs (1, 4) {
+	my $d = Digest::SHA::digest_files(256, \@files, { jobs => $jobs });
+	my $ok = keys(%$d) == @files;
+	for (0 .. $#files) {
+		$ok = 0 unless $d->{$files[$_]} eq sha256_hex($data[$_]);
+	}
+	print "not " unless $ok;
+	print "ok ", $testnum++, "\n";
+}
+
+my $d = Digest::SHA::digest_files("SHA-1", [$files[3]]);
+print "not " unless $d->{$files[3]} eq sha1_hex($data[3]);
+print "ok ", $testnum++, "\n";
+
+$d = Digest::SHA::digest_files(256, [$files[4]], { format => "base64" });
+print "not " unless $d->{$files[4]} eq sha256_base64($data[4]);
+print "ok ", $testnum++, "\n";
+
+$d = Digest::SHA::digest_files(512, [$files[5]], { format => "binary" });
+print "not " unless $d->{$files[5]} eq sha512($data[5]);
+print "ok ", $testnum++, "\n";
+
+my %err;
+my $missing = "digfile-missing.tmp";
+$d = Digest::SHA::digest_files(256, [$missing, $files[1]],
+	{ jobs => 2, errors => \%err });
+print "not " unless exists $d->{$missing} && !defined $d->{$missing} &&
+	$err{$missing} && !exists $err{$files[1]} &&
+	$d->{$files[1]} eq sha256_hex($data[1]);
+print "ok ", $testnum++, "\n";
+
+print "not " if defined Digest::SHA::digest_files(7, \@files) ||
+	defined Digest::SHA::digest_files(256, $files[0]) ||
+	defined Digest::SHA::digest_files(256, \@files, { format => "b64" });
+print "ok ", $testnum++, "\n";
@@ -0,0 +1,53 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw());
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# Compare the transforms and encoders selected for this CPU
+	# against the portable C code over a range of message sizes
+
+my @alg = (1, 224, 256, 384, 512, 512224, 512256);
+my @len = (0 .. 3, 55, 56, 63, 64, 65, 111, 112, 127, 128, 129,
+	1000, 4095, 16385);
+
+my $numtests = scalar @alg;
+print "1..$numtests\n";
+
+my $data = join('', map { chr(($_ * 131 + 7) % 256) } (0 .. 16384));
+
+sub digests {
+	my $alg = shift;
+	my $state = $MODULE->new($alg) or return;
+	my @d = map { $state->add(substr($data, 0, $_));
+		($state->clone->b64digest(url => 1, pad => 1),
+		$state->hexdigest) } @len;
+	push(@d, $state->add_bits($data, 8191)->add("x" x 200)->hexdigest);
+	return @d;
+}
+
+my $testnum = 1;
+for my $alg (@alg) {
+	if ($MODULE ne "Digest::SHA" || !$MODULE->new($alg)) {
+		print "ok ", $testnum++, " # skip: no hardware dispatch\n";
+		next;
+	}
+	Digest::SHA::shadispatch(~0);
+	my @hw = digests($alg);
+	Digest::SHA::shadispatch(0);
+	my @sw = digests($alg);
+	Digest::SHA::shadispatch(~0);
+	print "not " unless join(":", @hw) eq join(":", @sw);
+	print "ok ", $testnum++, "\n";
+}
@@ -0,0 +1,68 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw());
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# HMAC key objects must agree with the hmac_sha* functions for
+	# keys shorter than, equal to, and longer than the block size,
+	# and must give the same MAC however many times they're used
+
+my @algs = (1, 224, 256, 384, 512, 512224, 512256);
+my @keys = ("", "Jefe", "\x0b" x 20, "\xaa" x 64, "\xaa" x 128,
+	"\xaa" x 131);
+my @msgs = ("", "what do ya want for nothing?", "x" x 1000);
+
+my $numtests = @algs + 2;
+print "1..$numtests\n";
+
+unless ($MODULE eq "Digest::SHA" && eval { require Digest::SHA::HMAC }) {
+	print "ok $_ # skip: Digest::SHA::HMAC not available\n"
+		for (1 .. $numtests);
+	exit;
+}
+
+my $testnum = 1;
+for my $alg (@algs) {
+	my $ok = 1;
+	my $fcn = $MODULE->can("hmac_sha$alg");
+	if (!defined &$fcn("", "")) {
+		print "ok ", $testnum++, " # skip: SHA-$alg not supported\n";
+		next;
+	}
+	for my $key (@keys) {
+		my $hmac = Digest::SHA::HMAC->new($alg, $key);
+		for my $msg (@msgs, @msgs) {
+			$ok = 0 unless $hmac->mac($msg) eq &$fcn($msg, $key) &&
+				$hmac->mac_hex($msg) eq
+					unpack("H*", &$fcn($msg, $key));
+		}
+		$ok = 0 unless $hmac->algorithm == $alg &&
+			$hmac->hashsize == 8 * length(&$fcn("", $key));
+	}
+	print "not " unless $ok;
+	print "ok ", $testnum++, "\n";
+}
+
+	# RFC 4231, test case 2; messages given in pieces
+
+my $hmac = Digest::SHA::HMAC->new("sha256", "Jefe");
+print "not " unless $hmac->mac_hex("what do ya ", "want ", "for nothing?") eq
+	"5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843" &&
+	$hmac->mac_base64("what do ya want for nothing?") eq
+	Digest::SHA::hmac_sha256_base64("what do ya want for nothing?", "Jefe");
+print "ok ", $testnum++, "\n";
+
+print "not " if defined Digest::SHA::HMAC->new(2, "key");
+print "ok ", $testnum++, "\n";
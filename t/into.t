@@ -0,0 +1,101 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw());
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# Digests written into existing buffers must match the ones
+	# returned by the allocating functions and methods
+
+my $numtests = 10;
+print "1..$numtests\n";
+
+my $testnum = 1;
+
+unless ($MODULE eq "Digest::SHA") {
+	print "ok ", $testnum++, " # skip: no _into functions\n"
+		for 1 .. $numtests;
+	exit;
+}
+
+my @fcn = qw(sha1 sha224_hex sha256_base64 sha384 sha512_hex sha512256);
+my @msg = ("", "abc", "a" x 1000);
+
+my $ok = 1;
+my $buf = "x" x 200;
+for my $fcn (@fcn) {
+	my $one = $MODULE->can($fcn);
+	my $into = $MODULE->can($fcn . "_into");
+	next unless defined &$one("");
+	for my $msg (@msg) {
+		my $n = &$into($buf, $msg);
+		$ok = 0 unless $buf eq &$one($msg) && $n == length($buf);
+	}
+}
+print "not " unless $ok;
+print "ok ", $testnum++, "\n";
+
+my $data = "abc";
+$buf = undef;
+Digest::SHA::sha256_hex_into($buf, "a", "b", "c");
+print "not " unless $buf eq Digest::SHA::sha256_hex($data);
+print "ok ", $testnum++, "\n";
+
+	# aliasing the buffer and the data is allowed
+
+$buf = "abc";
+Digest::SHA::sha1_hex_into($buf, $buf);
+print "not " unless $buf eq "a9993e364706816aba3e25717850c26c9cd0d89d";
+print "ok ", $testnum++, "\n";
+
+my $sha = $MODULE->new(1);
+$buf = "HDR:";
+my $n = $sha->add("abc")->hexdigest_into($buf, 4);
+print "not " unless $n == 40 &&
+	$buf eq "HDR:a9993e364706816aba3e25717850c26c9cd0d89d";
+print "ok ", $testnum++, "\n";
+
+	# the object is reset, ready for the next message
+
+$sha->add("abc")->digest_into($buf);
+print "not " unless $buf eq $sha->add("abc")->digest;
+print "ok ", $testnum++, "\n";
+
+$buf = "ab";
+$sha->add("abc")->b64digest_into($buf, 4);
+print "not " unless $buf eq "ab\0\0qZk+NkcGgWq6PiVxeFDCbJzQ2J0";
+print "ok ", $testnum++, "\n";
+
+	# the buffer is reused in place when it's large enough
+
+$buf = "x" x 100;
+$sha->add("abc")->digest_into($buf, 10);
+print "not " unless length($buf) == 30 &&
+	substr($buf, 0, 10) eq "x" x 10;
+print "ok ", $testnum++, "\n";
+
+	# bad buffers and offsets leave the state alone
+
+$sha->add("abc");
+print "not " if defined $sha->digest_into("literal");
+print "ok ", $testnum++, "\n";
+
+$buf = "\x{100}";
+print "not " if defined $sha->digest_into($buf) ||
+	defined $sha->digest_into($buf = "", -1);
+print "ok ", $testnum++, "\n";
+
+print "not " unless $sha->hexdigest eq
+	"a9993e364706816aba3e25717850c26c9cd0d89d";
+print "ok ", $testnum++, "\n";
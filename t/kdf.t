@@ -0,0 +1,138 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw(pbkdf2 hkdf hkdf_extract hkdf_expand hmac_sha1
+		hmac_sha224 hmac_sha256 hmac_sha384 hmac_sha512
+		hmac_sha512224 hmac_sha512256));
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# PBKDF2-HMAC-SHA-1 vectors from RFC 6070 (the 16777216-iteration
+	# case is omitted for speed), and PBKDF2-HMAC-SHA-256 from RFC 7914
+
+my @pbkdf2 = (
+	[1, "password", "salt", 1, 20,
+		"0c60c80f961f0e71f3a9b524af6012062fe037a6"],
+	[1, "password", "salt", 2, 20,
+		"ea6c014dc72d6f8ccd1ed92ace1d41f0d8de8957"],
+	[1, "password", "salt", 4096, 20,
+		"4b007901b765489abead49d926f721d065a429c1"],
+	[1, "passwordPASSWORDpassword",
+		"saltSALTsaltSALTsaltSALTsaltSALTsalt", 4096, 25,
+		"3d2eec4fe41c849b80c8d83662c0e44a8b291a964cf2f07038"],
+	[1, "pass\0word", "sa\0lt", 4096, 16,
+		"56fa6aa75548099dcc37d7f03425e0c3"],
+	[256, "passwd", "salt", 1, 64,
+		"55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc" .
+		"49ca9cccf179b645991664b39d77ef317c71b845b1e30bd509112041d3a19783"],
+);
+
+	# HKDF vectors from RFC 5869 (test cases 1, 3, and 4)
+
+my @hkdf = (
+	[256, "\x0b" x 22, pack("H*", "000102030405060708090a0b0c"),
+		pack("H*", "f0f1f2f3f4f5f6f7f8f9"), 42,
+		"077709362c2e32df0ddc3f0dc47bba6390b6c73bb50f9c3122ec844ad7c2b3e5",
+		"3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db0" .
+		"2d56ecc4c5bf34007208d5b887185865"],
+	[256, "\x0b" x 22, "", "", 42,
+		"19ef24a32c717b167f33a91d6f648bdf96596776afdb6377ac434c1c293ccb04",
+		"8da4e775a563c18f715f802a063c5a31b8a11f5c5ee1879ec345" .
+		"4e5f3c738d2d9d201395faa4b61a96c8"],
+	[1, "\x0b" x 11, pack("H*", "000102030405060708090a0b0c"),
+		pack("H*", "f0f1f2f3f4f5f6f7f8f9"), 42,
+		"9b6c18c432a7bf8f0e71c8eb88f4b30baa2ba243",
+		"085a01ea1b10f36933068b56efa5ad81a4f14b822f5b091568a9" .
+		"cdd4f155fda2c22e422478d305f3f896"],
+);
+
+my @algs = (1, 224, 256, 384, 512, 512224, 512256);
+
+my $numtests = scalar(@pbkdf2) + 2 * scalar(@hkdf) + 2 * scalar(@algs) + 2;
+print "1..$numtests\n";
+
+my $testnum = 1;
+
+for my $v (@pbkdf2) {
+	my($alg, $pw, $salt, $c, $dklen, $rsp) = @$v;
+	my $dk = pbkdf2($alg, $pw, $salt, $c, $dklen);
+	print "not " unless defined $dk && unpack("H*", $dk) eq $rsp;
+	print "ok ", $testnum++, "\n";
+}
+
+for my $v (@hkdf) {
+	my($alg, $ikm, $salt, $info, $len, $prk, $okm) = @$v;
+	my $p = hkdf_extract($alg, $salt, $ikm);
+	print "not " unless defined $p && unpack("H*", $p) eq $prk;
+	print "ok ", $testnum++, "\n";
+	my $o = hkdf($alg, $ikm, $salt, $info, $len);
+	print "not " unless defined $o && unpack("H*", $o) eq $okm &&
+		hkdf_expand($alg, $p, $info, $len) eq $o;
+	print "ok ", $testnum++, "\n";
+}
+
+	# every algorithm must agree with PBKDF2 and HKDF built from
+	# the functional HMAC interface, including multi-block outputs
+
+sub refpbkdf2 {
+	my($hmac, $pw, $salt, $c, $dklen) = @_;
+	my $dk = "";
+	for (my $i = 1; length($dk) < $dklen; $i++) {
+		my $u = $hmac->($salt . pack("N", $i), $pw);
+		my $t = $u;
+		for (2 .. $c) {
+			$u = $hmac->($u, $pw);
+			$t ^= $u;
+		}
+		$dk .= $t;
+	}
+	substr($dk, 0, $dklen);
+}
+
+sub refhkdf {
+	my($hmac, $ikm, $salt, $info, $len) = @_;
+	my $prk = $hmac->($ikm, $salt);
+	my($t, $okm) = ("", "");
+	for (my $i = 1; length($okm) < $len; $i++) {
+		$t = $hmac->($t . $info . chr($i), $prk);
+		$okm .= $t;
+	}
+	substr($okm, 0, $len);
+}
+
+my $pw = "k" x 200;
+for my $alg (@algs) {
+	unless ($MODULE->new($alg)) {
+		print "ok ", $testnum++, " # skip: no 64-bit\n" for 1 .. 2;
+		next;
+	}
+	my $hmac = \&{"hmac_sha$alg"};
+	my $dk = pbkdf2("sha$alg", $pw, "NaCl", 5, 150);
+	print "not " unless defined $dk &&
+		$dk eq refpbkdf2($hmac, $pw, "NaCl", 5, 150);
+	print "ok ", $testnum++, "\n";
+	my $o = hkdf($alg, "ikm", "salt", "info", 100);
+	print "not " unless defined $o &&
+		$o eq refhkdf($hmac, "ikm", "salt", "info", 100);
+	print "ok ", $testnum++, "\n";
+}
+
+	# bad arguments yield undef
+
+print "not " if defined pbkdf2(257, "pw", "salt", 1) ||
+	defined pbkdf2(256, "pw", "salt", 0);
+print "ok ", $testnum++, "\n";
+
+print "not " if defined hkdf(1, "ikm", "salt", "info", 255 * 20 + 1) ||
+	length(hkdf(1, "ikm", "salt", "info", 255 * 20)) != 255 * 20;
+print "ok ", $testnum++, "\n";
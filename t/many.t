@@ -0,0 +1,60 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw());
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# The batch functions must agree with the one-shot functions,
+	# both with the default transforms and with the multi-buffer
+	# engine forced on (i.e. hiding SHA-NI, feature flag 0x08)
+
+my @fcn = qw(sha1 sha224_hex sha256_base64 sha384_hex sha512224);
+my @masks = (~0, ~0x08, 0);
+
+my $numtests = @fcn * @masks + 2;
+print "1..$numtests\n";
+
+my @msgs = map { join('', map { chr(($_ * 7 + 3) % 256) } (1 .. $_)) }
+	(0 .. 130, 447, 448, 1000, 4097);
+push(@msgs, "abc", "");
+
+my $testnum = 1;
+for my $mask (@masks) {
+	for my $fcn (@fcn) {
+		my $one = $MODULE->can($fcn);
+		my $many = $MODULE->can($fcn . "_many");
+		if (!$many || !defined(&$one(""))) {
+			print "ok ", $testnum++, " # skip: not supported\n";
+			next;
+		}
+		Digest::SHA::shadispatch($mask);
+		my @a = &$many(\@msgs);
+		my @b = map { &$one($_) } @msgs;
+		Digest::SHA::shadispatch(~0);
+		print "not " unless @a == @b && join(":", @a) eq join(":", @b);
+		print "ok ", $testnum++, "\n";
+	}
+}
+
+if ($MODULE eq "Digest::SHA") {
+	my @d = Digest::SHA::sha256_hex_many([]);
+	print "not " if @d;
+	print "ok ", $testnum++, "\n";
+	@d = Digest::SHA::sha1_hex_many(["abc"]);
+	print "not " unless $d[0] eq "a9993e364706816aba3e25717850c26c9cd0d89d";
+	print "ok ", $testnum++, "\n";
+}
+else {
+	print "ok ", $testnum++, " # skip: Digest::SHA only\n" for (1, 2);
+}
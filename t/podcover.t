@@ -29,6 +29,7 @@ my @privfcns = ();
 if ($MODULE eq "Digest::SHA") {
 	@privfcns = qw(
 		newSHA
+		shadispatch
 		shainit
 		sharewind
 		shawrite
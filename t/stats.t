@@ -0,0 +1,84 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw());
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# Counters are available only when built with -DSHA_STATS
+
+my $numtests = 6;
+print "1..$numtests\n";
+
+my $testnum = 1;
+
+unless ($MODULE eq "Digest::SHA") {
+	print "ok ", $testnum++, " # skip: no stats\n" for 1 .. $numtests;
+	exit;
+}
+
+my $sha = $MODULE->new(256);
+unless (defined $sha->stats) {
+	print "not " if defined Digest::SHA::global_stats();
+	print "ok ", $testnum++, "\n";
+	print "ok ", $testnum++, " # skip: built without SHA_STATS\n"
+		for 2 .. $numtests;
+	exit;
+}
+
+my $g0 = Digest::SHA::global_stats();
+
+	# 64 bytes in place, then 64 more in place and 36 buffered
+
+$sha->add("a" x 64)->add("b" x 100);
+my $st = $sha->stats;
+print "not " unless $st->{blocks} == 2 && $st->{direct} == 128 &&
+	$st->{bytes} == 36 && $st->{partial} == 1;
+print "ok ", $testnum++, "\n";
+
+	# digest finishes in one block, and keeps the counters
+
+$sha->digest;
+$st = $sha->stats;
+print "not " unless $st->{blocks} == 3 && $st->{finish} == 1;
+print "ok ", $testnum++, "\n";
+
+	# bit-aligned data goes through shabits
+
+$sha->add_bits("1")->add("c" x 10);
+print "not " unless $sha->stats->{bits} == 10;
+print "ok ", $testnum++, "\n";
+
+	# a fresh object starts from zero
+
+print "not " unless $MODULE->new(1)->stats->{blocks} == 0;
+print "ok ", $testnum++, "\n";
+
+	# files count reads and bytes read
+
+my $file = "stats.tmp";
+open(my $fh, "> $file") or die "can't open $file: $!";
+binmode($fh);
+print $fh "x" x 5000;
+close($fh);
+$st = $MODULE->new(1)->addfile($file, "b")->stats;
+unlink($file);
+print "not " unless $st->{reads} >= 1 && $st->{readbytes} == 5000;
+print "ok ", $testnum++, "\n";
+
+	# process-wide totals include all of the above
+
+my $g1 = Digest::SHA::global_stats();
+print "not " unless $g1->{blocks} - $g0->{blocks} >= 3 + 78 &&
+	$g1->{finish} > $g0->{finish};
+print "ok ", $testnum++, "\n";
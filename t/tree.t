@@ -0,0 +1,131 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw(sha1 sha256 sha512));
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# Tree digests must match the RFC 6962 Merkle tree hash computed
+	# directly from the leaves, whether the data arrives all at once,
+	# in odd-sized pieces, or from a file
+
+my @sizes = (0, 1, 1023, 1024, 1025, 4096, 7 * 1024 + 5, 300000);
+my %hash = (1 => \&sha1, 256 => \&sha256, 512 => \&sha512);
+
+my $numtests = scalar(@sizes) + scalar(keys %hash) + 5;
+print "1..$numtests\n";
+
+my $tempfile = "tree.tmp";
+END { 1 while unlink $tempfile }
+
+sub mth {
+	my($H, @leaves) = @_;
+	return $H->("\0" . $leaves[0]) if @leaves == 1;
+	my $k = 1;
+	$k <<= 1 while 2 * $k < @leaves;
+	$H->("\1" . mth($H, @leaves[0 .. $k-1]) .
+		mth($H, @leaves[$k .. $#leaves]));
+}
+
+sub refdigest {
+	my($alg, $data, $leafsize) = @_;
+	my @leaves = length($data) ? unpack("(a$leafsize)*", $data) : ("");
+	unpack("H*", mth($hash{$alg}, @leaves));
+}
+
+sub writefile {
+	my $data = shift;
+	local *F;
+	open(F, "> $tempfile") or die $!;
+	binmode(F);
+	print F $data;
+	close(F);
+}
+
+my $testnum = 1;
+for my $size (@sizes) {
+	my $data = join('', map { chr(($_ * 31 + 7) % 256) } (1 .. $size));
+	my $rsp = refdigest(256, $data, 1024);
+	my $ok = 1;
+	for my $jobs (1, 3) {
+		my $tree = $MODULE->new_tree(256, leaf_size => 1024,
+			jobs => $jobs);
+		$ok = 0 unless $tree->add($data)->hexdigest eq $rsp;
+		$tree->add($_) for unpack("(a7)*", $data);
+		$ok = 0 unless $tree->hexdigest eq $rsp;
+		writefile($data);
+		$ok = 0 unless $tree->addfile($tempfile)->hexdigest eq $rsp;
+	}
+	print "not " unless $ok;
+	print "ok ", $testnum++, "\n";
+}
+
+for my $alg (sort { $a <=> $b } keys %hash) {
+	unless ($MODULE->new($alg)) {
+		print "ok ", $testnum++, " # skip: no 64-bit\n";
+		next;
+	}
+	my $data = "abc" x 100000;
+	my $tree = $MODULE->new_tree("sha$alg", leaf_size => 4096);
+	print "not " unless $tree->digest eq
+		pack("H*", refdigest($alg, "", 4096)) &&
+		$tree->add($data)->hexdigest eq refdigest($alg, $data, 4096);
+	print "ok ", $testnum++, "\n";
+}
+
+	# the default leaf size is 1 MiB, and is part of the format
+
+my $data = "\x5a" x (3 << 20);
+my $tree = $MODULE->new_tree(256);
+print "not " unless $tree->leaf_size == 1 << 20 &&
+	$tree->add($data)->hexdigest eq refdigest(256, $data, 1 << 20);
+print "ok ", $testnum++, "\n";
+
+	# tree digests differ from plain digests of the same data
+
+print "not " if $MODULE->new_tree(256)->add("abc")->digest eq
+	sha256("abc");
+print "ok ", $testnum++, "\n";
+
+	# reading from an open handle, and resetting
+
+writefile($data);
+local *FH;
+open(FH, "< $tempfile") or die $!;
+binmode(FH);
+$tree->add("discarded")->reset;
+print "not " unless $tree->addfile(*FH)->hexdigest eq
+	refdigest(256, $data, 1 << 20);
+print "ok ", $testnum++, "\n";
+close(FH);
+
+	# accessors
+
+if ($MODULE->new(384)) {
+	$tree = $MODULE->new_tree(384, leaf_size => 2048, jobs => 2);
+	print "not " unless $tree->algorithm == 384 &&
+		$tree->hashsize == 384 && $tree->leaf_size == 2048 &&
+		$tree->jobs == 2;
+	print "ok ", $testnum++, "\n";
+}
+else {
+	print "ok ", $testnum++, " # skip: no 64-bit\n";
+}
+
+	# bad leaf sizes and algorithms are refused
+
+print "not " if defined $MODULE->new_tree(256, leaf_size => 1000) ||
+	defined $MODULE->new_tree(256, leaf_size => 512) ||
+	defined $MODULE->new_tree(256, leaf_size => 1 << 31) ||
+	defined $MODULE->new_tree(257);
+print "ok ", $testnum++, "\n";
@@ -0,0 +1,68 @@
+use strict;
+
+my $MODULE;
+
+BEGIN {
+	$MODULE = (-d "src") ? "Digest::SHA" : "Digest::SHA::PurePerl";
+	eval "require $MODULE" || die $@;
+	$MODULE->import(qw(sha1_hex));
+}
+
+BEGIN {
+	if ($ENV{PERL_CORE}) {
+		chdir 't' if -d 't';
+		@INC = '../lib';
+	}
+}
+
+	# Universal newlines ("U") and portable mode ("p") must convert
+	# runs of CRs the same way wherever the reads happen to split them
+
+sub univ {
+	my $data = shift;
+	$data =~ s/\015\012/\012/g;
+	$data =~ s/\015/\012/g;
+	return($data);
+}
+
+sub portable {
+	my $data = shift;
+	my $out = "";
+	for (split(/(?<=\012)/, $data)) {
+		s/\015?\015\012/\012/g;
+		s/\015/\012/g;
+		$out .= $_;
+	}
+	return($out);
+}
+
+my @pats = ("\r", "\r\n", "\r\r\n", "\r\r\r\n", "\r\rx", "\r\r\r");
+my @offs = (4094 .. 4097, 65533 .. 65537);
+
+my $numtests = @pats;
+print "1..$numtests\n";
+
+my $tempfile = "univ.tmp";
+END { 1 while unlink $tempfile }
+
+my $text = "plain line of text\n" x 3500;
+my $testnum = 1;
+for my $pat (@pats) {
+	my $ok = 1;
+	for my $off (@offs) {
+		for my $tail ("end\n", "") {
+			my $data = substr($text, 0, $off) . $pat . $tail;
+			local *F;
+			open(F, "> $tempfile") or die $!;
+			binmode(F);
+			print F $data;
+			close(F);
+			$ok = 0 unless $MODULE->new(1)->addfile($tempfile, "U")
+				->hexdigest eq sha1_hex(univ($data));
+			$ok = 0 unless $MODULE->new(1)->addfile($tempfile, "p")
+				->hexdigest eq sha1_hex(portable($data));
+		}
+	}
+	print "not " unless $ok;
+	print "ok ", $testnum++, "\n";
+}